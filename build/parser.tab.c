@@ -0,0 +1,1851 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison implementation for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* C LALR(1) parser skeleton written by Richard Stallman, by
+   simplifying the original so-called "semantic" parser.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+/* All symbols defined below should begin with yy or YY, to avoid
+   infringing on user name space.  This should be done even for local
+   variables, as they might otherwise be expanded by user macros.
+   There are some unavoidable exceptions within include files to
+   define necessary library symbols; they are noted "INFRINGES ON
+   USER NAME SPACE" below.  */
+
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
+
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
+
+/* Skeleton name.  */
+#define YYSKELETON_NAME "yacc.c"
+
+/* Pure parsers.  */
+#define YYPURE 0
+
+/* Push parsers.  */
+#define YYPUSH 0
+
+/* Pull parsers.  */
+#define YYPULL 1
+
+
+
+
+/* First part of user prologue.  */
+#line 1 "src/parser.y"
+
+#include <cstring>
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "parser.hpp"
+#include "trace.hpp"
+
+extern "C" int yylex();
+extern "C" int yyparse();
+extern "C" FILE *yyin;
+
+std::vector<MonsterType> monsterTypeList;
+std::vector<ObjectType> objectTypeList;
+MonsterType curr_monster;
+ObjectType curr_object;
+
+int parse(const char *filename) {
+    TraceSpan span("parse", "io");
+    yyin = fopen(filename, "r");
+    if (!yyin) {
+        std::cerr << "Cannot open file: " << filename << std::endl;
+        return 1;
+    }
+    yyparse();
+    if (yyin) {
+        fclose(yyin);
+    }
+
+    return 0;
+}
+
+void yyerror(const char *s) {
+    std::cerr << "Parse error: " << s << std::endl;
+}
+
+void reset_monster() {
+    curr_monster = MonsterType();
+}
+
+void reset_object() {
+    curr_object = ObjectType();
+}
+
+#line 118 "build/parser.tab.c"
+
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
+
+#include "parser.tab.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_HEADER_MONSTER = 3,             /* HEADER_MONSTER  */
+  YYSYMBOL_HEADER_OBJECT = 4,              /* HEADER_OBJECT  */
+  YYSYMBOL_BEGIN_MONSTER = 5,              /* BEGIN_MONSTER  */
+  YYSYMBOL_END_MONSTER = 6,                /* END_MONSTER  */
+  YYSYMBOL_BEGIN_OBJECT = 7,               /* BEGIN_OBJECT  */
+  YYSYMBOL_END_OBJECT = 8,                 /* END_OBJECT  */
+  YYSYMBOL_NAME = 9,                       /* NAME  */
+  YYSYMBOL_DESC = 10,                      /* DESC  */
+  YYSYMBOL_COLOR = 11,                     /* COLOR  */
+  YYSYMBOL_SPEED = 12,                     /* SPEED  */
+  YYSYMBOL_ABIL = 13,                      /* ABIL  */
+  YYSYMBOL_HP = 14,                        /* HP  */
+  YYSYMBOL_DAM = 15,                       /* DAM  */
+  YYSYMBOL_SYMB = 16,                      /* SYMB  */
+  YYSYMBOL_RRTY = 17,                      /* RRTY  */
+  YYSYMBOL_TYPE = 18,                      /* TYPE  */
+  YYSYMBOL_HIT = 19,                       /* HIT  */
+  YYSYMBOL_DODGE = 20,                     /* DODGE  */
+  YYSYMBOL_DEF = 21,                       /* DEF  */
+  YYSYMBOL_WEIGHT = 22,                    /* WEIGHT  */
+  YYSYMBOL_ATTR = 23,                      /* ATTR  */
+  YYSYMBOL_VAL = 24,                       /* VAL  */
+  YYSYMBOL_ART = 25,                       /* ART  */
+  YYSYMBOL_COLOR_VAL = 26,                 /* COLOR_VAL  */
+  YYSYMBOL_ABIL_VAL = 27,                  /* ABIL_VAL  */
+  YYSYMBOL_TYPE_VAL = 28,                  /* TYPE_VAL  */
+  YYSYMBOL_DICE = 29,                      /* DICE  */
+  YYSYMBOL_STRING = 30,                    /* STRING  */
+  YYSYMBOL_SYMBOL = 31,                    /* SYMBOL  */
+  YYSYMBOL_RARITY = 32,                    /* RARITY  */
+  YYSYMBOL_ART_VAL_TRUE = 33,              /* ART_VAL_TRUE  */
+  YYSYMBOL_ART_VAL_FALSE = 34,             /* ART_VAL_FALSE  */
+  YYSYMBOL_NEWLINE = 35,                   /* NEWLINE  */
+  YYSYMBOL_PERIOD = 36,                    /* PERIOD  */
+  YYSYMBOL_YYACCEPT = 37,                  /* $accept  */
+  YYSYMBOL_file = 38,                      /* file  */
+  YYSYMBOL_monsters = 39,                  /* monsters  */
+  YYSYMBOL_objects = 40,                   /* objects  */
+  YYSYMBOL_monster = 41,                   /* monster  */
+  YYSYMBOL_object = 42,                    /* object  */
+  YYSYMBOL_monster_fields = 43,            /* monster_fields  */
+  YYSYMBOL_object_fields = 44,             /* object_fields  */
+  YYSYMBOL_monster_field = 45,             /* monster_field  */
+  YYSYMBOL_object_field = 46,              /* object_field  */
+  YYSYMBOL_desc_content = 47,              /* desc_content  */
+  YYSYMBOL_color_content = 48,             /* color_content  */
+  YYSYMBOL_abil_content = 49,              /* abil_content  */
+  YYSYMBOL_abil_list = 50,                 /* abil_list  */
+  YYSYMBOL_val_content = 51                /* val_content  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
+
+
+
+
+#ifdef short
+# undef short
+#endif
+
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
+
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
+#endif
+
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
+#else
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
+#else
+typedef short yytype_uint8;
+#endif
+
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
+#else
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
+#endif
+
+#ifndef YYSIZE_T
+# ifdef __SIZE_TYPE__
+#  define YYSIZE_T __SIZE_TYPE__
+# elif defined size_t
+#  define YYSIZE_T size_t
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYSIZE_T size_t
+# else
+#  define YYSIZE_T unsigned
+# endif
+#endif
+
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
+
+#ifndef YY_
+# if defined YYENABLE_NLS && YYENABLE_NLS
+#  if ENABLE_NLS
+#   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
+#  endif
+# endif
+# ifndef YY_
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
+# endif
+#endif
+
+/* Suppress unused-variable warnings by "using" E.  */
+#if ! defined lint || defined __GNUC__
+# define YY_USE(E) ((void) (E))
+#else
+# define YY_USE(E) /* empty */
+#endif
+
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
+#else
+# define YY_INITIAL_VALUE(Value) Value
+#endif
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if !defined yyoverflow
+
+/* The parser invokes alloca or malloc; define the necessary symbols.  */
+
+# ifdef YYSTACK_USE_ALLOCA
+#  if YYSTACK_USE_ALLOCA
+#   ifdef __GNUC__
+#    define YYSTACK_ALLOC __builtin_alloca
+#   elif defined __BUILTIN_VA_ARG_INCR
+#    include <alloca.h> /* INFRINGES ON USER NAME SPACE */
+#   elif defined _AIX
+#    define YYSTACK_ALLOC __alloca
+#   elif defined _MSC_VER
+#    include <malloc.h> /* INFRINGES ON USER NAME SPACE */
+#    define alloca _alloca
+#   else
+#    define YYSTACK_ALLOC alloca
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
+#     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
+#     endif
+#    endif
+#   endif
+#  endif
+# endif
+
+# ifdef YYSTACK_ALLOC
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+    /* The OS might guarantee only one guard page at the bottom of the stack,
+       and a page size can be as small as 4096 bytes.  So we cannot safely
+       invoke alloca (N) if N exceeds 4096.  Use a slightly smaller number
+       to allow for a few compiler-allocated temporary stack slots.  */
+#   define YYSTACK_ALLOC_MAXIMUM 4032 /* reasonable circa 2006 */
+#  endif
+# else
+#  define YYSTACK_ALLOC YYMALLOC
+#  define YYSTACK_FREE YYFREE
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+#   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
+#  endif
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
+       && ! ((defined YYMALLOC || defined malloc) \
+             && (defined YYFREE || defined free)))
+#   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
+#   endif
+#  endif
+#  ifndef YYMALLOC
+#   define YYMALLOC malloc
+#   if ! defined malloc && ! defined EXIT_SUCCESS
+void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+#  ifndef YYFREE
+#   define YYFREE free
+#   if ! defined free && ! defined EXIT_SUCCESS
+void free (void *); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+# endif
+#endif /* !defined yyoverflow */
+
+#if (! defined yyoverflow \
+     && (! defined __cplusplus \
+         || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+
+/* A type that is properly aligned for any stack member.  */
+union yyalloc
+{
+  yy_state_t yyss_alloc;
+  YYSTYPE yyvs_alloc;
+};
+
+/* The size of the maximum gap between one aligned stack and the next.  */
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
+
+/* The size of an array large to enough to hold all stacks, each with
+   N elements.  */
+# define YYSTACK_BYTES(N) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
+      + YYSTACK_GAP_MAXIMUM)
+
+# define YYCOPY_NEEDED 1
+
+/* Relocate STACK from its old location to the new one.  The
+   local variables YYSIZE and YYSTACKSIZE give the old and new number of
+   elements in the stack, and YYPTR gives the new location of the
+   stack.  Advance YYPTR to a properly aligned location for the next
+   stack.  */
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
+
+#endif
+
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
+/* YYFINAL -- State number of the termination state.  */
+#define YYFINAL  6
+/* YYLAST -- Last index in YYTABLE.  */
+#define YYLAST   100
+
+/* YYNTOKENS -- Number of terminals.  */
+#define YYNTOKENS  37
+/* YYNNTS -- Number of nonterminals.  */
+#define YYNNTS  15
+/* YYNRULES -- Number of rules.  */
+#define YYNRULES  51
+/* YYNSTATES -- Number of states.  */
+#define YYNSTATES  103
+
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   291
+
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
+{
+       0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     1,     2,     3,     4,
+       5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
+      15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
+      25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
+      35,    36
+};
+
+#if YYDEBUG
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
+{
+       0,    74,    74,    75,    77,    78,    79,    85,    86,    87,
+      93,   106,   116,   117,   120,   121,   124,   129,   134,   139,
+     148,   153,   162,   171,   175,   179,   185,   190,   195,   200,
+     205,   214,   223,   232,   241,   250,   259,   268,   277,   281,
+     285,   289,   295,   296,   304,   309,   316,   319,   324,   329,
+     336,   341
+};
+#endif
+
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
+/* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
+   First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
+static const char *const yytname[] =
+{
+  "\"end of file\"", "error", "\"invalid token\"", "HEADER_MONSTER",
+  "HEADER_OBJECT", "BEGIN_MONSTER", "END_MONSTER", "BEGIN_OBJECT",
+  "END_OBJECT", "NAME", "DESC", "COLOR", "SPEED", "ABIL", "HP", "DAM",
+  "SYMB", "RRTY", "TYPE", "HIT", "DODGE", "DEF", "WEIGHT", "ATTR", "VAL",
+  "ART", "COLOR_VAL", "ABIL_VAL", "TYPE_VAL", "DICE", "STRING", "SYMBOL",
+  "RARITY", "ART_VAL_TRUE", "ART_VAL_FALSE", "NEWLINE", "PERIOD",
+  "$accept", "file", "monsters", "objects", "monster", "object",
+  "monster_fields", "object_fields", "monster_field", "object_field",
+  "desc_content", "color_content", "abil_content", "abil_list",
+  "val_content", YY_NULLPTR
+};
+
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
+{
+  return yytname[yysymbol];
+}
+#endif
+
+#define YYPACT_NINF (-24)
+
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
+
+#define YYTABLE_NINF (-4)
+
+#define yytable_value_is_error(Yyn) \
+  0
+
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int8 yypact[] =
+{
+      25,   -24,   -24,     5,     1,    42,   -24,   -24,   -24,   -24,
+     -24,   -24,   -24,    24,    -1,   -20,   -24,    -3,    18,    26,
+       2,    23,    27,    28,    29,    22,   -24,    20,   -24,    31,
+      18,    26,    30,    33,    32,    35,    36,    37,    38,    39,
+      40,    41,    12,   -24,   -24,    43,   -24,    -4,   -24,   -23,
+      44,   -24,    45,    46,    47,    48,    49,    50,   -24,    51,
+      17,   -22,    52,    53,    54,   -24,    16,    55,    56,    57,
+      58,    59,    60,    61,    62,   -24,   -24,   -24,   -24,   -24,
+     -24,   -24,   -24,   -24,   -24,   -24,   -24,   -24,   -24,   -24,
+     -24,   -24,   -24,   -24,   -24,   -24,   -24,   -24,   -24,   -24,
+     -24,   -24,   -24
+};
+
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
+{
+       0,     4,     7,     0,     0,     0,     1,     6,    12,     5,
+       9,    14,     8,     0,     0,     0,    10,     0,     0,     0,
+       0,    46,     0,     0,     0,     0,    13,     0,    11,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,    15,    25,     0,    42,     0,    44,     0,
+       0,    48,     0,    47,     0,     0,     0,     0,    41,     0,
+       0,     0,     0,     0,     0,    50,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,    16,    43,    17,    45,    18,
+      19,    20,    49,    21,    22,    23,    24,    26,    27,    29,
+      35,    31,    40,    51,    28,    30,    32,    33,    34,    36,
+      37,    38,    39
+};
+
+/* YYPGOTO[NTERM-NUM].  */
+static const yytype_int8 yypgoto[] =
+{
+     -24,   -24,   -24,   -24,   -24,   -24,   -24,   -24,   -24,   -24,
+      68,    69,   -24,   -24,   -24
+};
+
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_int8 yydefgoto[] =
+{
+       0,     3,     4,     5,     9,    12,    13,    14,    26,    43,
+      47,    49,    52,    53,    66
+};
+
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int8 yytable[] =
+{
+      27,    -2,     7,    78,    78,     6,     8,    28,    29,    30,
+      31,    32,    79,    89,    33,    44,    34,    35,    36,    37,
+      38,    39,    40,    41,    42,    15,    76,    45,     1,     2,
+      16,    50,    77,    17,    18,    19,    20,    21,    22,    23,
+      24,    25,    -3,    10,    93,    73,    74,    76,    46,    11,
+      51,    94,    48,    88,    57,    58,    54,    55,     0,    62,
+      56,    59,    63,    65,    64,    67,    68,    69,    70,    71,
+      72,     0,     0,    82,     0,     0,     0,     0,    75,    80,
+      81,     0,    83,    84,    85,    86,    87,    90,    91,    92,
+      95,    96,    97,    98,    99,   100,   101,   102,    60,     0,
+      61
+};
+
+static const yytype_int8 yycheck[] =
+{
+       1,     0,     1,    26,    26,     0,     5,     8,     9,    10,
+      11,    12,    35,    35,    15,    35,    17,    18,    19,    20,
+      21,    22,    23,    24,    25,     1,    30,    30,     3,     4,
+       6,    29,    36,     9,    10,    11,    12,    13,    14,    15,
+      16,    17,     0,     1,    28,    33,    34,    30,    30,     7,
+      27,    35,    26,    36,    32,    35,    29,    29,    -1,    29,
+      31,    30,    29,    28,    32,    29,    29,    29,    29,    29,
+      29,    -1,    -1,    27,    -1,    -1,    -1,    -1,    35,    35,
+      35,    -1,    35,    35,    35,    35,    35,    35,    35,    35,
+      35,    35,    35,    35,    35,    35,    35,    35,    30,    -1,
+      31
+};
+
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
+{
+       0,     3,     4,    38,    39,    40,     0,     1,     5,    41,
+       1,     7,    42,    43,    44,     1,     6,     9,    10,    11,
+      12,    13,    14,    15,    16,    17,    45,     1,     8,     9,
+      10,    11,    12,    15,    17,    18,    19,    20,    21,    22,
+      23,    24,    25,    46,    35,    30,    30,    47,    26,    48,
+      29,    27,    49,    50,    29,    29,    31,    32,    35,    30,
+      47,    48,    29,    29,    32,    28,    51,    29,    29,    29,
+      29,    29,    29,    33,    34,    35,    30,    36,    26,    35,
+      35,    35,    27,    35,    35,    35,    35,    35,    36,    35,
+      35,    35,    35,    28,    35,    35,    35,    35,    35,    35,
+      35,    35,    35
+};
+
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
+{
+       0,    37,    38,    38,    39,    39,    39,    40,    40,    40,
+      41,    42,    43,    43,    44,    44,    45,    45,    45,    45,
+      45,    45,    45,    45,    45,    45,    46,    46,    46,    46,
+      46,    46,    46,    46,    46,    46,    46,    46,    46,    46,
+      46,    46,    47,    47,    48,    48,    49,    49,    50,    50,
+      51,    51
+};
+
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     2,     2,     0,     2,     2,     0,     2,     2,
+       3,     3,     0,     2,     0,     2,     3,     3,     3,     3,
+       3,     3,     3,     3,     3,     2,     3,     3,     3,     3,
+       3,     3,     3,     3,     3,     3,     3,     3,     3,     3,
+       3,     2,     1,     2,     1,     2,     0,     1,     1,     2,
+       1,     2
+};
+
+
+enum { YYENOMEM = -2 };
+
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
+
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
+
+
+#define YYRECOVERING()  (!!yyerrstatus)
+
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
+
+
+/* Enable debugging if requested.  */
+#if YYDEBUG
+
+# ifndef YYFPRINTF
+#  include <stdio.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYFPRINTF fprintf
+# endif
+
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
+static void
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
+{
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  if (!yyvaluep)
+    return;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
+
+static void
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
+{
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
+
+  yy_symbol_value_print (yyo, yykind, yyvaluep);
+  YYFPRINTF (yyo, ")");
+}
+
+/*------------------------------------------------------------------.
+| yy_stack_print -- Print the state stack from its BOTTOM up to its |
+| TOP (included).                                                   |
+`------------------------------------------------------------------*/
+
+static void
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
+{
+  YYFPRINTF (stderr, "Stack now");
+  for (; yybottom <= yytop; yybottom++)
+    {
+      int yybot = *yybottom;
+      YYFPRINTF (stderr, " %d", yybot);
+    }
+  YYFPRINTF (stderr, "\n");
+}
+
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
+
+
+/*------------------------------------------------.
+| Report that the YYRULE is going to be reduced.  |
+`------------------------------------------------*/
+
+static void
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule)
+{
+  int yylno = yyrline[yyrule];
+  int yynrhs = yyr2[yyrule];
+  int yyi;
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
+  /* The symbols being reduced.  */
+  for (yyi = 0; yyi < yynrhs; yyi++)
+    {
+      YYFPRINTF (stderr, "   $%d = ", yyi + 1);
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)]);
+      YYFPRINTF (stderr, "\n");
+    }
+}
+
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, Rule); \
+} while (0)
+
+/* Nonzero means print parse trace.  It is left uninitialized so that
+   multiple parsers can coexist.  */
+int yydebug;
+#else /* !YYDEBUG */
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
+# define YY_STACK_PRINT(Bottom, Top)
+# define YY_REDUCE_PRINT(Rule)
+#endif /* !YYDEBUG */
+
+
+/* YYINITDEPTH -- initial size of the parser's stacks.  */
+#ifndef YYINITDEPTH
+# define YYINITDEPTH 200
+#endif
+
+/* YYMAXDEPTH -- maximum size the stacks can grow to (effective only
+   if the built-in stack extension method is used).
+
+   Do not make this value too large; the results are undefined if
+   YYSTACK_ALLOC_MAXIMUM < YYSTACK_BYTES (YYMAXDEPTH)
+   evaluated with infinite-precision integer arithmetic.  */
+
+#ifndef YYMAXDEPTH
+# define YYMAXDEPTH 10000
+#endif
+
+
+
+
+
+
+/*-----------------------------------------------.
+| Release the memory associated to this symbol.  |
+`-----------------------------------------------*/
+
+static void
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep)
+{
+  YY_USE (yyvaluep);
+  if (!yymsg)
+    yymsg = "Deleting";
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/* Lookahead token kind.  */
+int yychar;
+
+/* The semantic value of the lookahead symbol.  */
+YYSTYPE yylval;
+/* Number of syntax errors so far.  */
+int yynerrs;
+
+
+
+
+/*----------.
+| yyparse.  |
+`----------*/
+
+int
+yyparse (void)
+{
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
+
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
+
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
+
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
+
+  int yyn;
+  /* The return value of yyparse.  */
+  int yyresult;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
+  /* The variables used to return semantic value and location from the
+     action routines.  */
+  YYSTYPE yyval;
+
+
+
+#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
+
+  /* The number of symbols on the RHS of the reduced rule.
+     Keep to zero when no symbol should be popped.  */
+  int yylen = 0;
+
+  YYDPRINTF ((stderr, "Starting parse\n"));
+
+  yychar = YYEMPTY; /* Cause a token to be read.  */
+
+  goto yysetstate;
+
+
+/*------------------------------------------------------------.
+| yynewstate -- push a new state, which is found in yystate.  |
+`------------------------------------------------------------*/
+yynewstate:
+  /* In all cases, when you get here, the value and location stacks
+     have just been pushed.  So pushing a state here evens the stacks.  */
+  yyssp++;
+
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
+
+  if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
+    {
+      /* Get the current used size of the three stacks, in elements.  */
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
+
+# if defined yyoverflow
+      {
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
+      }
+# else /* defined YYSTACK_RELOCATE */
+      /* Extend the stack our own way.  */
+      if (YYMAXDEPTH <= yystacksize)
+        YYNOMEM;
+      yystacksize *= 2;
+      if (YYMAXDEPTH < yystacksize)
+        yystacksize = YYMAXDEPTH;
+
+      {
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+#  undef YYSTACK_RELOCATE
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
+      }
+# endif
+
+      yyssp = yyss + yysize - 1;
+      yyvsp = yyvs + yysize - 1;
+
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
+
+      if (yyss + yystacksize - 1 <= yyssp)
+        YYABORT;
+    }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
+
+
+  if (yystate == YYFINAL)
+    YYACCEPT;
+
+  goto yybackup;
+
+
+/*-----------.
+| yybackup.  |
+`-----------*/
+yybackup:
+  /* Do appropriate processing given the current state.  Read a
+     lookahead token if we need one and don't already have one.  */
+
+  /* First try to decide what to do without reference to lookahead token.  */
+  yyn = yypact[yystate];
+  if (yypact_value_is_default (yyn))
+    goto yydefault;
+
+  /* Not known => get a lookahead token if don't already have one.  */
+
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
+  if (yychar == YYEMPTY)
+    {
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex ();
+    }
+
+  if (yychar <= YYEOF)
+    {
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
+      YYDPRINTF ((stderr, "Now at end of input.\n"));
+    }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
+  else
+    {
+      yytoken = YYTRANSLATE (yychar);
+      YY_SYMBOL_PRINT ("Next token is", yytoken, &yylval, &yylloc);
+    }
+
+  /* If the proper action on seeing token YYTOKEN is to reduce or to
+     detect an error, take that action.  */
+  yyn += yytoken;
+  if (yyn < 0 || YYLAST < yyn || yycheck[yyn] != yytoken)
+    goto yydefault;
+  yyn = yytable[yyn];
+  if (yyn <= 0)
+    {
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
+      yyn = -yyn;
+      goto yyreduce;
+    }
+
+  /* Count tokens shifted since error; after three, turn off error
+     status.  */
+  if (yyerrstatus)
+    yyerrstatus--;
+
+  /* Shift the lookahead token.  */
+  YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
+  yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
+  goto yynewstate;
+
+
+/*-----------------------------------------------------------.
+| yydefault -- do the default action for the current state.  |
+`-----------------------------------------------------------*/
+yydefault:
+  yyn = yydefact[yystate];
+  if (yyn == 0)
+    goto yyerrlab;
+  goto yyreduce;
+
+
+/*-----------------------------.
+| yyreduce -- do a reduction.  |
+`-----------------------------*/
+yyreduce:
+  /* yyn is the number of a rule to reduce with.  */
+  yylen = yyr2[yyn];
+
+  /* If YYLEN is nonzero, implement the default value of the action:
+     '$$ = $1'.
+
+     Otherwise, the following line sets YYVAL to garbage.
+     This behavior is undocumented and Bison
+     users should not rely upon it.  Assigning to YYVAL
+     unconditionally makes the parser a bit smaller, and it avoids a
+     GCC warning that YYVAL may be used uninitialized.  */
+  yyval = yyvsp[1-yylen];
+
+
+  YY_REDUCE_PRINT (yyn);
+  switch (yyn)
+    {
+  case 6: /* monsters: monsters error  */
+#line 79 "src/parser.y"
+                          { 
+            std::cerr << "Error in monster definition, discarding" << std::endl; 
+            reset_monster(); 
+        }
+#line 1224 "build/parser.tab.c"
+    break;
+
+  case 9: /* objects: objects error  */
+#line 87 "src/parser.y"
+                         { 
+            std::cerr << "Error in object definition, discarding" << std::endl; 
+            reset_object(); 
+        }
+#line 1233 "build/parser.tab.c"
+    break;
+
+  case 10: /* monster: BEGIN_MONSTER monster_fields END_MONSTER  */
+#line 93 "src/parser.y"
+                                                  {
+            if (curr_monster.fields.size() != 9 || !curr_monster.valid) {
+                curr_monster.valid = false;
+                std::cerr << "Parse error: Invalid monster (incomplete or duplicate), discarding" << std::endl;
+            }
+            else {
+                curr_monster.proto.colors = compileColors(curr_monster.colors);
+                curr_monster.proto.abilities = compileAbilities(curr_monster.abils);
+                monsterTypeList.push_back(curr_monster);
+            }
+            reset_monster();
+        }
+#line 1250 "build/parser.tab.c"
+    break;
+
+  case 11: /* object: BEGIN_OBJECT object_fields END_OBJECT  */
+#line 106 "src/parser.y"
+                                              {
+            if (curr_object.fields.size() != 14 || !curr_object.valid) {
+                curr_object.valid = false;
+                std::cerr << "Parse error: Invalid object" << std::endl;
+            }
+            curr_object.proto = compileObjectTypes(curr_object.types, curr_object.colors);
+            objectTypeList.push_back(curr_object);
+            reset_object();
+        }
+#line 1264 "build/parser.tab.c"
+    break;
+
+  case 16: /* monster_field: NAME STRING NEWLINE  */
+#line 124 "src/parser.y"
+                                   {
+                  if (!curr_monster.fields.insert("NAME").second) curr_monster.valid = false;
+                  curr_monster.name = (yyvsp[-1].str);
+                  free((yyvsp[-1].str));
+              }
+#line 1274 "build/parser.tab.c"
+    break;
+
+  case 17: /* monster_field: DESC desc_content PERIOD  */
+#line 129 "src/parser.y"
+                                         {
+                  if (!curr_monster.fields.insert("DESC").second) curr_monster.valid = false;
+                  curr_monster.desc = (yyvsp[-1].str);
+                  free((yyvsp[-1].str));
+              }
+#line 1284 "build/parser.tab.c"
+    break;
+
+  case 18: /* monster_field: COLOR color_content NEWLINE  */
+#line 134 "src/parser.y"
+                                            {
+                  if (!curr_monster.fields.insert("COLOR").second) curr_monster.valid = false;
+                  curr_monster.colors = *(yyvsp[-1].str_vec);
+                  delete (yyvsp[-1].str_vec);
+              }
+#line 1294 "build/parser.tab.c"
+    break;
+
+  case 19: /* monster_field: SPEED DICE NEWLINE  */
+#line 139 "src/parser.y"
+                                   {
+                  if (!curr_monster.fields.insert("SPEED").second) curr_monster.valid = false;
+                  int set = sscanf((yyvsp[-1].str), "%d+%dd%d", &curr_monster.speed.base, &curr_monster.speed.rolls, &curr_monster.speed.sides);
+                  if (set != 3) {
+                        curr_monster.valid = false;
+                        std::cerr << "Parse error: Invalid Speed format" << std::endl;
+                  }
+                  free((yyvsp[-1].str));
+              }
+#line 1308 "build/parser.tab.c"
+    break;
+
+  case 20: /* monster_field: ABIL abil_content NEWLINE  */
+#line 148 "src/parser.y"
+                                          {
+                  if (!curr_monster.fields.insert("ABIL").second) curr_monster.valid = false;
+                  curr_monster.abils = *(yyvsp[-1].str_vec);
+                  delete (yyvsp[-1].str_vec);
+              }
+#line 1318 "build/parser.tab.c"
+    break;
+
+  case 21: /* monster_field: HP DICE NEWLINE  */
+#line 153 "src/parser.y"
+                                {
+                  if (!curr_monster.fields.insert("HP").second) curr_monster.valid = false;
+                  int set = sscanf((yyvsp[-1].str), "%d+%dd%d", &curr_monster.hp.base, &curr_monster.hp.rolls, &curr_monster.hp.sides);
+                  if (set != 3) {
+                        curr_monster.valid = false;
+                        std::cerr << "Parse error: Invalid HP format" << std::endl;
+                  }
+                  free((yyvsp[-1].str));
+              }
+#line 1332 "build/parser.tab.c"
+    break;
+
+  case 22: /* monster_field: DAM DICE NEWLINE  */
+#line 162 "src/parser.y"
+                                 {
+                  if (!curr_monster.fields.insert("DAM").second) curr_monster.valid = false;
+                  int set = sscanf((yyvsp[-1].str), "%d+%dd%d", &curr_monster.dam.base, &curr_monster.dam.rolls, &curr_monster.dam.sides);
+                  if (set != 3) {
+                        curr_monster.valid = false;
+                        std::cerr << "Parse error: Invalid Damage format" << std::endl;
+                  }
+                  free((yyvsp[-1].str));
+              }
+#line 1346 "build/parser.tab.c"
+    break;
+
+  case 23: /* monster_field: SYMB SYMBOL NEWLINE  */
+#line 171 "src/parser.y"
+                                    {
+                  if (!curr_monster.fields.insert("SYMB").second) curr_monster.valid = false;
+                  curr_monster.symbol = (yyvsp[-1].ch);
+              }
+#line 1355 "build/parser.tab.c"
+    break;
+
+  case 24: /* monster_field: RRTY RARITY NEWLINE  */
+#line 175 "src/parser.y"
+                                    {
+                  if (!curr_monster.fields.insert("RRTY").second) curr_monster.valid = false;
+                  curr_monster.rarity = (yyvsp[-1].num);
+              }
+#line 1364 "build/parser.tab.c"
+    break;
+
+  case 25: /* monster_field: error NEWLINE  */
+#line 179 "src/parser.y"
+                              { 
+                  std::cerr << "Error in field, monster is invalid" << std::endl; 
+                  curr_monster.valid = false; 
+              }
+#line 1373 "build/parser.tab.c"
+    break;
+
+  case 26: /* object_field: NAME STRING NEWLINE  */
+#line 185 "src/parser.y"
+                                  {
+                  if (!curr_object.fields.insert("NAME").second) curr_object.valid = false;
+                  curr_object.name = (yyvsp[-1].str);
+                  free((yyvsp[-1].str));
+              }
+#line 1383 "build/parser.tab.c"
+    break;
+
+  case 27: /* object_field: DESC desc_content PERIOD  */
+#line 190 "src/parser.y"
+                                         {
+                  if (!curr_object.fields.insert("DESC").second) curr_object.valid = false;
+                  curr_object.desc = (yyvsp[-1].str);
+                  free((yyvsp[-1].str));
+              }
+#line 1393 "build/parser.tab.c"
+    break;
+
+  case 28: /* object_field: TYPE val_content NEWLINE  */
+#line 195 "src/parser.y"
+                                         {
+                  if (!curr_object.fields.insert("TYPE").second) curr_object.valid = false;
+                  curr_object.types = *(yyvsp[-1].str_vec);
+                  delete (yyvsp[-1].str_vec);
+              }
+#line 1403 "build/parser.tab.c"
+    break;
+
+  case 29: /* object_field: COLOR color_content NEWLINE  */
+#line 200 "src/parser.y"
+                                            {
+                  if (!curr_object.fields.insert("COLOR").second) curr_object.valid = false;
+                  curr_object.colors = *(yyvsp[-1].str_vec);
+                  delete (yyvsp[-1].str_vec);
+              }
+#line 1413 "build/parser.tab.c"
+    break;
+
+  case 30: /* object_field: HIT DICE NEWLINE  */
+#line 205 "src/parser.y"
+                                 {
+                  if (!curr_object.fields.insert("HIT").second) curr_object.valid = false;
+                  int set = sscanf((yyvsp[-1].str), "%d+%dd%d", &curr_object.hit.base, &curr_object.hit.rolls, &curr_object.hit.sides);
+                  if (set != 3) {
+                        curr_monster.valid = false;
+                        std::cerr << "Parse error: Invalid Hit format" << std::endl;
+                  }
+                  free((yyvsp[-1].str));
+              }
+#line 1427 "build/parser.tab.c"
+    break;
+
+  case 31: /* object_field: DAM DICE NEWLINE  */
+#line 214 "src/parser.y"
+                                 {
+                  if (!curr_object.fields.insert("DAM").second) curr_object.valid = false;
+                  int set = sscanf((yyvsp[-1].str), "%d+%dd%d", &curr_object.dam.base, &curr_object.dam.rolls, &curr_object.dam.sides);
+                  if (set != 3) {
+                        curr_monster.valid = false;
+                        std::cerr << "Parse error: Invalid Damage format" << std::endl;
+                  }
+                  free((yyvsp[-1].str));
+              }
+#line 1441 "build/parser.tab.c"
+    break;
+
+  case 32: /* object_field: DODGE DICE NEWLINE  */
+#line 223 "src/parser.y"
+                                   {
+                  if (!curr_object.fields.insert("DODGE").second) curr_object.valid = false;
+                  int set = sscanf((yyvsp[-1].str), "%d+%dd%d", &curr_object.dodge.base, &curr_object.dodge.rolls, &curr_object.dodge.sides);
+                  if (set != 3) {
+                        curr_monster.valid = false;
+                        std::cerr << "Parse error: Invalid Dodge format" << std::endl;
+                  }
+                  free((yyvsp[-1].str));
+              }
+#line 1455 "build/parser.tab.c"
+    break;
+
+  case 33: /* object_field: DEF DICE NEWLINE  */
+#line 232 "src/parser.y"
+                                 {
+                  if (!curr_object.fields.insert("DEF").second) curr_object.valid = false;
+                  int set = sscanf((yyvsp[-1].str), "%d+%dd%d", &curr_object.def.base, &curr_object.def.rolls, &curr_object.def.sides);
+                  if (set != 3) {
+                        curr_monster.valid = false;
+                        std::cerr << "Parse error: Invalid Defense format" << std::endl;
+                  }
+                  free((yyvsp[-1].str));
+              }
+#line 1469 "build/parser.tab.c"
+    break;
+
+  case 34: /* object_field: WEIGHT DICE NEWLINE  */
+#line 241 "src/parser.y"
+                                    {
+                  if (!curr_object.fields.insert("WEIGHT").second) curr_object.valid = false;
+                  int set = sscanf((yyvsp[-1].str), "%d+%dd%d", &curr_object.weight.base, &curr_object.weight.rolls, &curr_object.weight.sides);
+                  if (set != 3) {
+                        curr_monster.valid = false;
+                        std::cerr << "Parse error: Invalid Weight format" << std::endl;
+                  }
+                  free((yyvsp[-1].str));
+              }
+#line 1483 "build/parser.tab.c"
+    break;
+
+  case 35: /* object_field: SPEED DICE NEWLINE  */
+#line 250 "src/parser.y"
+                                   {
+                  if (!curr_object.fields.insert("SPEED").second) curr_object.valid = false;
+                  int set = sscanf((yyvsp[-1].str), "%d+%dd%d", &curr_object.speed.base, &curr_object.speed.rolls, &curr_object.speed.sides);
+                  if (set != 3) {
+                        curr_monster.valid = false;
+                        std::cerr << "Parse error: Invalid Speed format" << std::endl;
+                  }
+                  free((yyvsp[-1].str));
+              }
+#line 1497 "build/parser.tab.c"
+    break;
+
+  case 36: /* object_field: ATTR DICE NEWLINE  */
+#line 259 "src/parser.y"
+                                  {
+                  if (!curr_object.fields.insert("ATTR").second) curr_object.valid = false;
+                  int set = sscanf((yyvsp[-1].str), "%d+%dd%d", &curr_object.attr.base, &curr_object.attr.rolls, &curr_object.attr.sides);
+                  if (set != 3) {
+                        curr_monster.valid = false;
+                        std::cerr << "Parse error: Invalid Attribute format" << std::endl;
+                  }
+                  free((yyvsp[-1].str));
+              }
+#line 1511 "build/parser.tab.c"
+    break;
+
+  case 37: /* object_field: VAL DICE NEWLINE  */
+#line 268 "src/parser.y"
+                                 {
+                  if (!curr_object.fields.insert("VAL").second) curr_object.valid = false;
+                  int set = sscanf((yyvsp[-1].str), "%d+%dd%d", &curr_object.val.base, &curr_object.val.rolls, &curr_object.val.sides);
+                  if (set != 3) {
+                        curr_monster.valid = false;
+                        std::cerr << "Parse error: Invalid Value format" << std::endl;
+                  }
+                  free((yyvsp[-1].str));
+              }
+#line 1525 "build/parser.tab.c"
+    break;
+
+  case 38: /* object_field: ART ART_VAL_TRUE NEWLINE  */
+#line 277 "src/parser.y"
+                                         {
+                  if (!curr_object.fields.insert("ART").second) curr_object.valid = false;
+                  curr_object.art = true;
+              }
+#line 1534 "build/parser.tab.c"
+    break;
+
+  case 39: /* object_field: ART ART_VAL_FALSE NEWLINE  */
+#line 281 "src/parser.y"
+                                          {
+                  if (!curr_object.fields.insert("ART").second) curr_object.valid = false;
+                  curr_object.art = false;
+              }
+#line 1543 "build/parser.tab.c"
+    break;
+
+  case 40: /* object_field: RRTY RARITY NEWLINE  */
+#line 285 "src/parser.y"
+                                    {
+                  if (!curr_object.fields.insert("RRTY").second) curr_object.valid = false;
+                  curr_object.rarity = (yyvsp[-1].num);
+              }
+#line 1552 "build/parser.tab.c"
+    break;
+
+  case 41: /* object_field: error NEWLINE  */
+#line 289 "src/parser.y"
+                              { 
+                  std::cerr << "Error in field, object is invalid" << std::endl; 
+                  curr_object.valid = false; 
+              }
+#line 1561 "build/parser.tab.c"
+    break;
+
+  case 42: /* desc_content: STRING  */
+#line 295 "src/parser.y"
+                     { (yyval.str) = strdup((yyvsp[0].str)); free((yyvsp[0].str)); }
+#line 1567 "build/parser.tab.c"
+    break;
+
+  case 43: /* desc_content: desc_content STRING  */
+#line 296 "src/parser.y"
+                                    {
+                  std::string temp = std::string((yyvsp[-1].str)) + (yyvsp[0].str);
+                  (yyval.str) = strdup(temp.c_str());
+                  free((yyvsp[-1].str));
+                  free((yyvsp[0].str));
+              }
+#line 1578 "build/parser.tab.c"
+    break;
+
+  case 44: /* color_content: COLOR_VAL  */
+#line 304 "src/parser.y"
+                         {
+                (yyval.str_vec) = new std::vector<std::string>();
+                (yyval.str_vec)->push_back((yyvsp[0].str));
+                free((yyvsp[0].str));
+             }
+#line 1588 "build/parser.tab.c"
+    break;
+
+  case 45: /* color_content: color_content COLOR_VAL  */
+#line 309 "src/parser.y"
+                                       {
+                (yyval.str_vec) = (yyvsp[-1].str_vec);
+                (yyval.str_vec)->push_back((yyvsp[0].str));
+                free((yyvsp[0].str));
+             }
+#line 1598 "build/parser.tab.c"
+    break;
+
+  case 46: /* abil_content: %empty  */
+#line 316 "src/parser.y"
+                           {
+                (yyval.str_vec) = new std::vector<std::string>();
+            }
+#line 1606 "build/parser.tab.c"
+    break;
+
+  case 47: /* abil_content: abil_list  */
+#line 319 "src/parser.y"
+                        {
+                (yyval.str_vec) = (yyvsp[0].str_vec);
+            }
+#line 1614 "build/parser.tab.c"
+    break;
+
+  case 48: /* abil_list: ABIL_VAL  */
+#line 324 "src/parser.y"
+                    {
+                (yyval.str_vec) = new std::vector<std::string>();
+                (yyval.str_vec)->push_back((yyvsp[0].str));
+                free((yyvsp[0].str));
+            }
+#line 1624 "build/parser.tab.c"
+    break;
+
+  case 49: /* abil_list: abil_list ABIL_VAL  */
+#line 329 "src/parser.y"
+                                 {
+                (yyval.str_vec) = (yyvsp[-1].str_vec);
+                (yyval.str_vec)->push_back((yyvsp[0].str));
+                free((yyvsp[0].str));
+            }
+#line 1634 "build/parser.tab.c"
+    break;
+
+  case 50: /* val_content: TYPE_VAL  */
+#line 336 "src/parser.y"
+                      {
+                (yyval.str_vec) = new std::vector<std::string>();
+                (yyval.str_vec)->push_back((yyvsp[0].str));
+                free((yyvsp[0].str));
+            }
+#line 1644 "build/parser.tab.c"
+    break;
+
+  case 51: /* val_content: val_content TYPE_VAL  */
+#line 341 "src/parser.y"
+                                   {
+                (yyval.str_vec) = (yyvsp[-1].str_vec);
+                (yyval.str_vec)->push_back((yyvsp[0].str));
+                free((yyvsp[0].str));
+            }
+#line 1654 "build/parser.tab.c"
+    break;
+
+
+#line 1658 "build/parser.tab.c"
+
+      default: break;
+    }
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
+
+  YYPOPSTACK (yylen);
+  yylen = 0;
+
+  *++yyvsp = yyval;
+
+  /* Now 'shift' the result of the reduction.  Determine what state
+     that goes to, based on the state we popped back to and the rule
+     number reduced by.  */
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
+
+  goto yynewstate;
+
+
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
+yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
+  /* If not already recovering from an error, report this error.  */
+  if (!yyerrstatus)
+    {
+      ++yynerrs;
+      yyerror (YY_("syntax error"));
+    }
+
+  if (yyerrstatus == 3)
+    {
+      /* If just tried and failed to reuse lookahead token after an
+         error, discard it.  */
+
+      if (yychar <= YYEOF)
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
+      else
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval);
+          yychar = YYEMPTY;
+        }
+    }
+
+  /* Else will try to reuse lookahead token after shifting the error
+     token.  */
+  goto yyerrlab1;
+
+
+/*---------------------------------------------------.
+| yyerrorlab -- error raised explicitly by YYERROR.  |
+`---------------------------------------------------*/
+yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
+
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYERROR.  */
+  YYPOPSTACK (yylen);
+  yylen = 0;
+  YY_STACK_PRINT (yyss, yyssp);
+  yystate = *yyssp;
+  goto yyerrlab1;
+
+
+/*-------------------------------------------------------------.
+| yyerrlab1 -- common code for both syntax error and YYERROR.  |
+`-------------------------------------------------------------*/
+yyerrlab1:
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
+
+  /* Pop stack until we find a state that shifts the error token.  */
+  for (;;)
+    {
+      yyn = yypact[yystate];
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
+
+      /* Pop the current state because it cannot handle the error token.  */
+      if (yyssp == yyss)
+        YYABORT;
+
+
+      yydestruct ("Error: popping",
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp);
+      YYPOPSTACK (1);
+      yystate = *yyssp;
+      YY_STACK_PRINT (yyss, yyssp);
+    }
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+
+  /* Shift the error token.  */
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
+
+  yystate = yyn;
+  goto yynewstate;
+
+
+/*-------------------------------------.
+| yyacceptlab -- YYACCEPT comes here.  |
+`-------------------------------------*/
+yyacceptlab:
+  yyresult = 0;
+  goto yyreturnlab;
+
+
+/*-----------------------------------.
+| yyabortlab -- YYABORT comes here.  |
+`-----------------------------------*/
+yyabortlab:
+  yyresult = 1;
+  goto yyreturnlab;
+
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
+yyexhaustedlab:
+  yyerror (YY_("memory exhausted"));
+  yyresult = 2;
+  goto yyreturnlab;
+
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != YYEMPTY)
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYABORT or YYACCEPT.  */
+  YYPOPSTACK (yylen);
+  YY_STACK_PRINT (yyss, yyssp);
+  while (yyssp != yyss)
+    {
+      yydestruct ("Cleanup: popping",
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp);
+      YYPOPSTACK (1);
+    }
+#ifndef yyoverflow
+  if (yyss != yyssa)
+    YYSTACK_FREE (yyss);
+#endif
+
+  return yyresult;
+}
+
+#line 347 "src/parser.y"
+
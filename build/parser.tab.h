@@ -0,0 +1,129 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison interface for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+#ifndef YY_YY_BUILD_PARSER_TAB_H_INCLUDED
+# define YY_YY_BUILD_PARSER_TAB_H_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 0
+#endif
+#if YYDEBUG
+extern int yydebug;
+#endif
+/* "%code requires" blocks.  */
+#line 48 "src/parser.y"
+
+    #include <string>
+    #include <vector>
+
+#line 54 "build/parser.tab.h"
+
+/* Token kinds.  */
+#ifndef YYTOKENTYPE
+# define YYTOKENTYPE
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    HEADER_MONSTER = 258,          /* HEADER_MONSTER  */
+    HEADER_OBJECT = 259,           /* HEADER_OBJECT  */
+    BEGIN_MONSTER = 260,           /* BEGIN_MONSTER  */
+    END_MONSTER = 261,             /* END_MONSTER  */
+    BEGIN_OBJECT = 262,            /* BEGIN_OBJECT  */
+    END_OBJECT = 263,              /* END_OBJECT  */
+    NAME = 264,                    /* NAME  */
+    DESC = 265,                    /* DESC  */
+    COLOR = 266,                   /* COLOR  */
+    SPEED = 267,                   /* SPEED  */
+    ABIL = 268,                    /* ABIL  */
+    HP = 269,                      /* HP  */
+    DAM = 270,                     /* DAM  */
+    SYMB = 271,                    /* SYMB  */
+    RRTY = 272,                    /* RRTY  */
+    TYPE = 273,                    /* TYPE  */
+    HIT = 274,                     /* HIT  */
+    DODGE = 275,                   /* DODGE  */
+    DEF = 276,                     /* DEF  */
+    WEIGHT = 277,                  /* WEIGHT  */
+    ATTR = 278,                    /* ATTR  */
+    VAL = 279,                     /* VAL  */
+    ART = 280,                     /* ART  */
+    COLOR_VAL = 281,               /* COLOR_VAL  */
+    ABIL_VAL = 282,                /* ABIL_VAL  */
+    TYPE_VAL = 283,                /* TYPE_VAL  */
+    DICE = 284,                    /* DICE  */
+    STRING = 285,                  /* STRING  */
+    SYMBOL = 286,                  /* SYMBOL  */
+    RARITY = 287,                  /* RARITY  */
+    ART_VAL_TRUE = 288,            /* ART_VAL_TRUE  */
+    ART_VAL_FALSE = 289,           /* ART_VAL_FALSE  */
+    NEWLINE = 290,                 /* NEWLINE  */
+    PERIOD = 291                   /* PERIOD  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
+#endif
+
+/* Value type.  */
+#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
+union YYSTYPE
+{
+#line 53 "src/parser.y"
+
+    int num;
+    char ch;
+    char *str;
+    bool bo;
+    std::vector<std::string> *str_vec;
+
+#line 115 "build/parser.tab.h"
+
+};
+typedef union YYSTYPE YYSTYPE;
+# define YYSTYPE_IS_TRIVIAL 1
+# define YYSTYPE_IS_DECLARED 1
+#endif
+
+
+extern YYSTYPE yylval;
+
+
+int yyparse (void);
+
+
+#endif /* !YY_YY_BUILD_PARSER_TAB_H_INCLUDED  */
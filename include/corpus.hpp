@@ -0,0 +1,16 @@
+#pragma once
+
+class LevelStats {
+public:
+    int level;
+    unsigned int seed;
+    int rooms;
+    int corridorCells;
+    int openCells;
+    int reachableCells;
+    int stairDistance;
+};
+
+// Generates levels 0..levels-1 from levelSeed(seed, level) on worker processes and writes each one
+// in the save format to outDir along with a tab separated index.tsv of LevelStats
+int generateCorpus(int levels, int workers, unsigned int seed, const char *outDir);
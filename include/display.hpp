@@ -1,5 +1,6 @@
 #pragma once
 
+#include <ncurses.h>
 #include <string>
 #include <utility>
 #include <vector>
@@ -10,26 +11,30 @@ static const int MESSAGE_LINE = 0;
 static const int STATUS_LINE1 = 22;
 static const int STATUS_LINE2 = 23;
 
+void initColorPairs();
 void printParsedMonsters();
 void printParsedObjects();
 void fitString(std::string& str, int maxWidth);
 void printLine(int line, const char *format, ...);
 void printLineColor(int line, Color color, const char *format, ...);
 void printStatus();
+WINDOW *openPanel(int height, int width, int startY, int startX);
+void refreshPanels();
+void closePanel(WINDOW *win);
 void redisplayColors();
 void redisplayColorsOutsideWindow(int height, int width, int startY, int startX);
 void characterInfo();
 void openEquipment();
 void openInventory();
 void printDungeon();
+// printDungeon without scrolling to the player
+void drawDungeon();
 void monsterList();
 void objectList();
 void showMonsterInfo(Pos pos);
-void nonTunnelingDistMap();
 void showEquipmentObjectDescription();
 void showInventoryObjectDescription();
 void viewActions(std::vector<std::pair<std::string, Color>>& actions);
-void tunnelingDistMap();
 void commandList();
 void lossScreen();
 void winScreen();
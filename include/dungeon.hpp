@@ -8,6 +8,9 @@
 #include <utility>
 #include <vector>
 
+#include "entityArena.hpp"
+#include "globals.hpp"
+#include "grid.hpp"
 #include "parser.hpp"
 
 static const char FLOOR = '.';
@@ -17,10 +20,17 @@ static const char STAIR_DOWN = '>';
 static const char ROCK = ' ';
 static const char FOG = ' ';
 
-static const int MAX_WIDTH = 80;
-static const int MAX_HEIGHT = 21;
+static const int DEFAULT_WIDTH = 80;
+static const int DEFAULT_HEIGHT = 21;
+// The map area of the screen, a larger dungeon scrolls underneath it
+static const int VIEW_WIDTH = 80;
+static const int VIEW_HEIGHT = 21;
+static const int MAX_DUNGEON_WIDTH = 2000;
+static const int MAX_DUNGEON_HEIGHT = 2000;
 static const int MAX_HARDNESS = 255;
 static const int ATTEMPTS = 1000;
+// Random spots a room tries before every spot it fits is listed
+static const int ROOM_SAMPLES = 32;
 static const int UNREACHABLE = 9999;
 
 // change with class/race
@@ -36,34 +46,6 @@ static const int INVENTORY_SIZE = 10;
 static const int DEFENSE_SCALE = 50;
 static const int HIT_SCALE = 75;
 
-enum class Color {
-    Black = 1,
-    Red,
-    Green,
-    Yellow,
-    Blue,
-    Magenta,
-    Cyan,
-    White
-};
-
-enum class Equip {
-    Weapon,
-    Offhand,
-    Ranged,
-    Armor,
-    Helmet,
-    Cloak,
-    Gloves,
-    Boots,
-    Amulet,
-    Light,
-    Ring1,
-    Ring2,
-    Count,
-    None
-};
-
 struct Pos {
     int x;
     int y;
@@ -92,30 +74,49 @@ class Tile {
 public:
     char type;
     int hardness;
-    int tunnelingDist;
-    int nonTunnelingDist;
     char visible;
 };
 
-extern Tile dungeon[MAX_HEIGHT][MAX_WIDTH];
+extern int dungeonWidth;
+extern int dungeonHeight;
+extern Grid<Tile> dungeon;
 extern int roomCount;
 extern std::vector<Room> rooms;
 extern std::vector<Pos> upStairs;
 extern int upStairsCount;
 extern std::vector<Pos> downStairs;
 extern int downStairsCount;
+extern unsigned int nextEntityId;
+
+// Color phase depends only on the animation clock and the entity, so drawing has no side effects
+inline Color phaseColor(const std::vector<Color>& colors, unsigned int entityId) {
+    return colors[(animationTick + entityId) % colors.size()];
+}
+
+// The rolled state of an object, everything else comes back from its type
+class ObjectRecord {
+public:
+    int objTypeIndex;
+    unsigned int entityId;
+    int hitBonus;
+    Dice damageBonus;
+    int dodgeBonus;
+    int defenseBonus;
+    int weight;
+    int speedBonus;
+    int specialAttribute;
+    int value;
+    Equip equipIndex;
+    Pos pos;
+};
 
+// Only what was rolled lives on the object, the rest is shared with its type
 class Object {
 private:
+    const ObjectType *type;
     int objTypeIndex;
-    std::string name;
-    std::string description;
-    std::vector<std::string> types;
-    std::string typeString;
     Equip equipIndex;
-    std::vector<Color> colors;
-    int colorCount;
-    int colorIndex;
+    unsigned int entityId;
     int hitBonus;
     Dice damageBonus;
     int dodgeBonus;
@@ -124,24 +125,21 @@ private:
     int speedBonus;
     int specialAttribute;
     int value;
-    bool artifact;
-    char symbol;
-    int rarity;
     Pos pos;
+    int slot = -1;
+    Object *below = nullptr;
 
 public:
     int getObjTypeIndex() { return objTypeIndex; }
 
-    std::string getName() { return name; }
+    const std::string& getName() const { return type->name; }
 
-    std::string getDescription() { return description; }
+    const std::string& getDescription() const { return type->desc; }
 
-    std::vector<std::string> getTypes() { return types; }
-    std::string getTypeString() { return typeString; }
+    ObjectKind getKind() const { return type->proto.kind; }
+    const std::string& getTypeString() const { return type->proto.typeString; }
 
-    bool isTwoHanded() {
-        return types.size() == 2;
-    }
+    bool isTwoHanded() const { return type->proto.twoHanded; }
     Equip getEquipmentIndex() {
         return equipIndex;
     }
@@ -149,12 +147,9 @@ public:
         equipIndex = index;
     }
 
-    Color getColor() {
-        if (colorIndex >= colorCount) {
-            colorIndex = 0;
-        }
-        return colors[colorIndex++];
-    }
+    Color getColor() { return phaseColor(type->proto.colors, entityId); }
+    bool isMultiColored() { return type->proto.colors.size() > 1; }
+    unsigned int getEntityId() { return entityId; }
 
     int getHitBonus() { return hitBonus; }
     Dice getDamageBonus() { return damageBonus; }
@@ -164,72 +159,151 @@ public:
     int getSpeedBonus() { return speedBonus; }
     int getSpecialAttribute() { return specialAttribute; }
     int getValue() { return value; }
-    bool isArtifact() { return artifact; }
-    char getSymbol() { return symbol; }
-    int getRarity() { return rarity; }
+    bool isArtifact() const { return type->art; }
+    char getSymbol() const { return type->proto.symbol; }
+    int getRarity() const { return type->rarity; }
 
     Pos getPos() { return pos; }
     void setPos(Pos p) { pos = p; }
+    // Where the object sits in objectStore, -1 while it is off the level
+    int getSlot() const { return slot; }
+    void setSlot(int s) { slot = s; }
+    // The next object down the pile, piles are linked through the objects themselves
+    Object *getBelow() const { return below; }
+    void setBelow(Object *obj) { below = obj; }
+
+    ObjectRecord getRecord() {
+        return (ObjectRecord){objTypeIndex, entityId, hitBonus, damageBonus, dodgeBonus, defenseBonus, weight,
+                              speedBonus, specialAttribute, value, equipIndex, pos};
+    }
+
+    static void *operator new(size_t size);
+    static void *operator new(size_t size, LevelArena& arena);
+    static void operator delete(void *slot);
+    static void operator delete(void *slot, LevelArena& arena);
 
     Object(ObjectType* objType, int objTypeIndex, Pos pos) {
+        type = objType;
         this->objTypeIndex = objTypeIndex;
-        name = objType->name;
-        description = objType->desc;
-        types = objType->types;
-        for (const auto& color : objType->colors) {
-            if (color == "BLACK") { colors.push_back(Color::Black); }
-            else if (color == "RED") { colors.push_back(Color::Red); }
-            else if (color == "GREEN") { colors.push_back(Color::Green); }
-            else if (color == "YELLOW") { colors.push_back(Color::Yellow); }
-            else if (color == "BLUE") { colors.push_back(Color::Blue); }
-            else if (color == "MAGENTA") { colors.push_back(Color::Magenta); }
-            else if (color == "CYAN") { colors.push_back(Color::Cyan); }
-            else if (color == "WHITE") { colors.push_back(Color::White); }
-        }
-        colorCount = colors.size();
-        colorIndex = 0;
-        hitBonus = objType->hit.base + objType->hit.rolls * (rand() % objType->hit.sides + 1);
-        damageBonus = Dice(objType->dam.base, objType->dam.rolls, objType->dam.sides);
-        dodgeBonus = objType->dodge.base + objType->dodge.rolls * (rand() % objType->dodge.sides + 1);
-        defenseBonus = objType->def.base + objType->def.rolls * (rand() % objType->def.sides + 1);
-        weight = objType->weight.base + objType->weight.rolls * (rand() % objType->weight.sides + 1);
-        speedBonus = objType->speed.base + objType->speed.rolls * (rand() % objType->speed.sides + 1);
-        specialAttribute = objType->attr.base + objType->attr.rolls * (rand() % objType->attr.sides + 1);
-        value = objType->val.base + objType->val.rolls * (rand() % objType->val.sides + 1);
-        artifact = objType->art;
-        if (types.size() == 2) {
-            symbol = ')'; equipIndex = Equip::Weapon; typeString = "Weapon";
-        }
-        if (types.size() == 1) {
-            if (types.front() == "WEAPON") { symbol = '|'; equipIndex = Equip::Weapon; typeString = "Weapon"; }
-            else if (types.front() == "OFFHAND") { symbol = ')'; equipIndex = Equip::Offhand; typeString = "Offhand"; }
-            else if (types.front() == "RANGED") { symbol = '}'; equipIndex = Equip::Ranged; typeString = "Ranged"; }
-            else if (types.front() == "ARMOR") { symbol = '['; equipIndex = Equip::Armor; typeString = "Armor"; }
-            else if (types.front() == "HELMET") { symbol = ']'; equipIndex = Equip::Helmet; typeString = "Helmet"; }
-            else if (types.front() == "CLOAK") { symbol = '('; equipIndex = Equip::Cloak; typeString = "Cloak"; }
-            else if (types.front() == "GLOVES") { symbol = '{'; equipIndex = Equip::Gloves; typeString = "Gloves"; }
-            else if (types.front() == "BOOTS") { symbol = '\\'; equipIndex = Equip::Boots; typeString = "Boots"; }
-            else if (types.front() == "RING") { symbol = '='; equipIndex = Equip::Ring1; typeString = "Ring"; }
-            else if (types.front() == "AMULET") { symbol = '"'; equipIndex = Equip::Amulet; typeString = "Ring"; }
-            else if (types.front() == "LIGHT") { symbol = '_'; equipIndex = Equip::Light; typeString = "Light"; }
-            else if (types.front() == "SCROLL") { symbol = '~'; equipIndex = Equip::None; typeString = "Scroll"; }
-            else if (types.front() == "BOOK") { symbol = '?'; equipIndex = Equip::None; typeString = "Book"; }
-            else if (types.front() == "FLASK") { symbol = '!'; equipIndex = Equip::None; typeString = "Flask"; }
-            else if (types.front() == "GOLD") { symbol = '$'; equipIndex = Equip::None; typeString = "Gold"; }
-            else if (types.front() == "AMMUNITION") { symbol = '/'; equipIndex = Equip::None; typeString = "Ammunition"; }
-            else if (types.front() == "FOOD") { symbol = ','; equipIndex = Equip::None; typeString = "Food"; }
-            else if (types.front() == "WAND") { symbol = '-'; equipIndex = Equip::None; typeString = "Wand"; }
-            else if (types.front() == "CONTAINER") { symbol = '%'; equipIndex = Equip::None; typeString = "Container"; }
-            else { symbol = '*'; }
-        }
-        rarity = objType->rarity;
+        equipIndex = objType->proto.equip;
+        entityId = nextEntityId++;
+        hitBonus = objType->hit.roll();
+        damageBonus = objType->dam;
+        dodgeBonus = objType->dodge.roll();
+        defenseBonus = objType->def.roll();
+        weight = objType->weight.roll();
+        speedBonus = objType->speed.roll();
+        specialAttribute = objType->attr.roll();
+        value = objType->val.roll();
         this->pos = pos;
     }
+    // Brings back an object exactly as it was rolled, without touching rand() or the entity ids
+    Object(ObjectType* objType, const ObjectRecord& record) {
+        type = objType;
+        objTypeIndex = record.objTypeIndex;
+        entityId = record.entityId;
+        hitBonus = record.hitBonus;
+        damageBonus = record.damageBonus;
+        dodgeBonus = record.dodgeBonus;
+        defenseBonus = record.defenseBonus;
+        weight = record.weight;
+        speedBonus = record.speedBonus;
+        specialAttribute = record.specialAttribute;
+        value = record.value;
+        equipIndex = record.equipIndex;
+        pos = record.pos;
+    }
     Object() = delete;
     ~Object() = default;
 };
 
-extern std::vector<std::unique_ptr<Object>> objectsAt[MAX_HEIGHT][MAX_WIDTH];
+// Every object on the level packed together, each knows its own slot since a pile holds several.
+// Removing an object moves the last one into its slot
+class ObjectStore {
+public:
+    std::vector<Object *> entities;
+    std::vector<Pos> pos;
+
+    int size() const { return entities.size(); }
+    int add(Object *obj);
+    // Returns the object moved into the slot, or nullptr if it was the last
+    Object *remove(int slot);
+    void clear();
+};
+
+extern ObjectStore objectStore;
+// Slot in objectStore of the top object on each cell, or -1
+extern Grid<int> pileHead;
+
+// One cell's objects, walked from the top down. back() is the top, the one drawn and picked up
+class Pile {
+private:
+    Object *top;
+
+public:
+    class iterator {
+    private:
+        Object *at;
+
+    public:
+        Object *operator*() const { return at; }
+        iterator& operator++() {
+            at = at->getBelow();
+            return *this;
+        }
+        bool operator!=(const iterator& other) const { return at != other.at; }
+
+        explicit iterator(Object *at) : at(at) {}
+    };
+
+    bool empty() const { return top == nullptr; }
+    Object *back() const { return top; }
+    size_t size() const {
+        size_t count = 0;
+        for (Object *obj = top; obj != nullptr; obj = obj->getBelow()) {
+            count++;
+        }
+        return count;
+    }
+    iterator begin() const { return iterator(top); }
+    iterator end() const { return iterator(nullptr); }
+
+    explicit Pile(Object *top) : top(top) {}
+};
+
+// Reads pileHead as objectsAt[y][x], giving the pile on the cell. Changes go through placeObject
+// and liftObject
+class PileMap {
+public:
+    class Row {
+    private:
+        const int *heads;
+
+    public:
+        [[gnu::always_inline]] Pile operator[](int x) const {
+            return Pile(heads[x] == -1 ? nullptr : objectStore.entities[heads[x]]);
+        }
+
+        explicit Row(const int *heads) : heads(heads) {}
+    };
+
+    [[gnu::always_inline]] Row operator[](int y) const { return Row(pileHead[y]); }
+};
+
+extern PileMap objectsAt;
+
+class Monster;
+
+// The rosters in entityList.cpp mirror what is on the floor, these keep them in step with the grids
+void trackMonster(Monster *mon);
+void untrackMonster(Monster *mon);
+void trackObject(Object *obj);
+void untrackObject(Object *obj);
+
+// Puts an object on top of the pile at its position
+void placeObject(Object *obj);
+// Takes an object off the level, it is left to its arena
+void liftObject(Object *obj);
 
 class Character {
 protected:
@@ -339,15 +413,23 @@ public:
     bool addToInventory(Pos pos) {
         for (int i = 0; i < INVENTORY_SIZE; i++) {
             if (inventory[i] == nullptr) {
-                inventory[i] = std::move(objectsAt[pos.y][pos.x].back());
-                objectsAt[pos.y][pos.x].pop_back();
+                Object *obj = objectsAt[pos.y][pos.x].back();
+                untrackObject(obj);
+                liftObject(obj);
+                // Copied out of the level's arena, which goes away with the level
+                inventory[i].reset(new (*playerArena) Object(*obj));
+                delete obj;
                 return true;
             }
         }
         return false;
     }
     void dropFromInventory(int index) {
-        objectsAt[pos.y][pos.x].push_back(std::move(inventory[index]));
+        Object *obj = new Object(*inventory[index]);
+        inventory[index] = nullptr;
+        obj->setPos(pos);
+        placeObject(obj);
+        trackObject(obj);
     }
     void expungeFromInventory(int index) {
         inventory[index] = nullptr;
@@ -360,7 +442,7 @@ public:
         int damage = 0;
         for (std::unique_ptr<Object>& obj : equipment) {
             if (obj == nullptr) { continue; }
-            damage += obj.get()->getDamageBonus().base + obj.get()->getDamageBonus().rolls * (rand() % obj.get()->getDamageBonus().sides + 1);
+            damage += obj.get()->getDamageBonus().roll();
         }
         if (equipment[static_cast<int>(Equip::Weapon)] == nullptr) {
             damage += 0 + 1 * (rand() % 4 + 1);
@@ -399,130 +481,172 @@ public:
 
 extern Player player;
 
+// Where a monster stands and what its rolls came to, everything else comes back from its type
+class MonsterRecord {
+public:
+    int monTypeIndex;
+    unsigned int entityId;
+    int maxHitpoints;
+    int hitpoints;
+    int speed;
+    Pos pos;
+    Pos lastSeen;
+};
+
+// Only what was rolled or changes in play lives on the monster, the rest is shared with its type
 class Monster : public Character {
 private:
+    const MonsterType *type;
     int monTypeIndex;
-    std::string name;
-    std::string description;
-    std::vector<Color> colors;
-    int colorCount;
-    int colorIndex; 
-    bool intelligent;
-    bool telepathic;
-    bool tunneling;
-    bool erratic;
-    bool pass;
-    bool pickup;
-    bool destroy;
-    bool unique;
-    bool boss;
-    Dice dam;
-    char symbol;
-    int rarity;
+    unsigned int entityId;
     Pos lastSeen;
 
 public:
     int getMonTypeIndex() { return monTypeIndex; }
 
-    std::string getName() { return name; }
+    const std::string& getName() const { return type->name; }
 
-    std::string getDescription() { return description; }
+    const std::string& getDescription() const { return type->desc; }
 
-    Color getColor() {
-        if (colorIndex >= colorCount) {
-            colorIndex = 0;
-        }
-        return colors[colorIndex++];
-    }
+    Color getColor() { return phaseColor(type->proto.colors, entityId); }
+    bool isMultiColored() { return type->proto.colors.size() > 1; }
+    unsigned int getEntityId() { return entityId; }
 
     int doDamage() {
         int damage = 0;
         for (std::unique_ptr<Object>& obj : equipment) {
             if (obj == nullptr) { continue; }
-            damage += obj.get()->getDamageBonus().base + obj.get()->getDamageBonus().rolls * (rand() % obj.get()->getDamageBonus().sides + 1);
+            damage += obj.get()->getDamageBonus().roll();
         }
-        damage += dam.base + dam.rolls * (rand() % dam.sides + 1);
+        damage += type->dam.roll();
         return damage;
     }
 
-    bool isIntelligent() { return intelligent; }
-    bool isTelepathic() { return telepathic; }
-    bool isTunneling() { return tunneling; }
-    bool isErratic() { return erratic; }
-    bool canPass() { return pass; }
-    bool canPickup() { return pickup; }
-    bool canDestroy() { return destroy; }
-    bool isUnique() { return unique; }
-    bool isBoss() { return boss; }
+    bool isIntelligent() const { return type->proto.abilities & ABIL_SMART; }
+    bool isTelepathic() const { return type->proto.abilities & ABIL_TELE; }
+    bool isTunneling() const { return type->proto.abilities & ABIL_TUNNEL; }
+    bool isErratic() const { return type->proto.abilities & ABIL_ERRATIC; }
+    bool canPass() const { return type->proto.abilities & ABIL_PASS; }
+    bool canPickup() const { return type->proto.abilities & ABIL_PICKUP; }
+    bool canDestroy() const { return type->proto.abilities & ABIL_DESTROY; }
+    bool isUnique() const { return type->proto.abilities & ABIL_UNIQ; }
+    bool isBoss() const { return type->proto.abilities & ABIL_BOSS; }
+    unsigned int getAbilities() const { return type->proto.abilities; }
 
-    char getSymbol() { return symbol; }
-    int getRarity() { return rarity; }
+    char getSymbol() const { return type->symbol; }
+    int getRarity() const { return type->rarity; }
 
     Pos getLastSeen() { return lastSeen; }
     void setLastSeen(Pos p) { lastSeen = p; }
 
+    MonsterRecord getRecord() {
+        return (MonsterRecord){monTypeIndex, entityId, maxHitpoints, hitpoints, speed, pos, lastSeen};
+    }
+
+    static void *operator new(size_t size);
+    static void *operator new(size_t size, LevelArena& arena);
+    static void operator delete(void *slot);
+    static void operator delete(void *slot, LevelArena& arena);
+
     Monster(MonsterType* monType, int monTypeIndex, Pos pos) {
         this->pos = pos;
-        maxHitpoints = monType->hp.base + monType->hp.rolls * (rand() % monType->hp.sides + 1);
+        maxHitpoints = monType->hp.roll();
         hitpoints = maxHitpoints;
         hitBonus = BASE_HIT_BONUS;
         dodgeBonus = BASE_DODGE_BONUS;
         defense = BASE_DEFENSE;
-        speed = monType->speed.base + monType->speed.rolls * (rand() % monType->speed.sides + 1);
+        speed = monType->speed.roll();
 
+        type = monType;
         this->monTypeIndex = monTypeIndex;
-        name = monType->name;
-        description = monType->desc;
-        for (const auto& color : monType->colors) {
-            if (color == "BLACK") { colors.push_back(Color::Black); }
-            else if (color == "RED") { colors.push_back(Color::Red); }
-            else if (color == "GREEN") { colors.push_back(Color::Green); }
-            else if (color == "YELLOW") { colors.push_back(Color::Yellow); }
-            else if (color == "BLUE") { colors.push_back(Color::Blue); }
-            else if (color == "MAGENTA") { colors.push_back(Color::Magenta); }
-            else if (color == "CYAN") { colors.push_back(Color::Cyan); }
-            else if (color == "WHITE") { colors.push_back(Color::White); }
-        }
-        colorCount = colors.size();
-        colorIndex = 0;
-        
-        intelligent = false;
-        telepathic = false;
-        tunneling = false;
-        erratic = false;
-        pass = false;
-        pickup = false;
-        destroy = false;
-        unique = false;
-        boss = false;
-        for (const auto& abil : monType->abils) {
-            if (abil == "SMART") { intelligent = true; }
-            else if (abil == "TELE") { telepathic = true; }
-            else if (abil == "TUNNEL") { tunneling = true; }
-            else if (abil == "ERRATIC") { erratic = true; }
-            else if (abil == "PASS") { pass = true; }
-            else if (abil == "PICKUP") { pickup = true; }
-            else if (abil == "DESTROY") { destroy = true; }
-            else if (abil == "UNIQ") { unique = true; }
-            else if (abil == "BOSS") { boss = true; }
-        }
-        dam = Dice(monType->dam.base, monType->dam.rolls, monType->dam.sides);
-        symbol = monType->symbol;
-        rarity = monType->rarity;
+        entityId = nextEntityId++;
         lastSeen = {-1, -1};
     }
+    // Brings back a monster as it was, without touching rand() or the entity ids
+    Monster(MonsterType* monType, const MonsterRecord& record) {
+        pos = record.pos;
+        maxHitpoints = record.maxHitpoints;
+        hitpoints = record.hitpoints;
+        hitBonus = BASE_HIT_BONUS;
+        dodgeBonus = BASE_DODGE_BONUS;
+        defense = BASE_DEFENSE;
+        speed = record.speed;
+
+        type = monType;
+        monTypeIndex = record.monTypeIndex;
+        entityId = record.entityId;
+        lastSeen = record.lastSeen;
+    }
     Monster() = delete;
     ~Monster() = default;  
 };
 
-extern std::unique_ptr<Monster> monsterAt[MAX_HEIGHT][MAX_WIDTH];
-extern std::vector<std::unique_ptr<Monster>> monsters;
+// Every monster on the level packed together, so walking them costs the monster count rather than
+// the map area. What the scheduler reads sits in parallel arrays beside the pointers. Removing a
+// monster moves the last one into its slot
+class MonsterStore {
+public:
+    std::vector<Monster *> entities;
+    std::vector<Pos> pos;
+    std::vector<int> speed;
+    std::vector<unsigned int> flags;
+
+    int size() const { return entities.size(); }
+    int add(Monster *mon);
+    // Returns the monster moved into the slot, or nullptr if it was the last
+    Monster *remove(int slot);
+    void clear();
+};
+
+extern MonsterStore monsterStore;
+// Slot in monsterStore of the monster on each cell, or -1
+extern Grid<int> monsterIndex;
+
+// Reads monsterIndex as monsterAt[y][x], giving the monster on the cell or nullptr. Changes go
+// through the functions below so the index and the store agree
+class MonsterMap {
+public:
+    class Row {
+    private:
+        const int *slots;
+
+    public:
+        [[gnu::always_inline]] Monster *operator[](int x) const {
+            return slots[x] == -1 ? nullptr : monsterStore.entities[slots[x]];
+        }
+
+        explicit Row(const int *slots) : slots(slots) {}
+    };
+
+    [[gnu::always_inline]] Row operator[](int y) const { return Row(monsterIndex[y]); }
+};
+
+extern MonsterMap monsterAt;
+
+// Puts a monster on the level at its position, which must be free
+void placeMonster(Monster *mon);
+void moveMonster(Monster *mon, Pos to);
+void swapMonsters(Monster *a, Monster *b);
+// Takes a monster off the level, it is left to its arena
+void liftMonster(Monster *mon);
+// Takes a monster off the level and frees it
+void removeMonster(Monster *mon);
 
+// Sizes every per-cell grid, the level is cleared
+void resizeDungeon(int width, int height);
 void initDungeon();
 void spawnPlayer();
 void printHardness();
 int spawnMonsterWithMonType(char monType);
 int spawnMonsters(int numMonsters, int playerX, int playerY);
 int spawnObjects(int numObjects);
+void buildFloorSums();
+int floorInRect(int x, int y, int width, int height);
+int countFloor(int x, int y, int width, int height);
+int placeRoom(Room& room);
+int buildRooms();
+void digCorridor(Room& from, Room& to);
+void buildCorridors();
+int buildStairs();
 int generateStructures();
 void clearAll();
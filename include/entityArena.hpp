@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+static const size_t SLAB_BYTES = 64 * 1024;
+
+// Totals over every arena, printed by --stats
+class ArenaStats {
+public:
+    long allocations = 0;
+    long frees = 0;
+    // Entities dropped with their level instead of one at a time
+    long bulkFreed = 0;
+    long bulkReleases = 0;
+    long slabsAllocated = 0;
+    long peakLive = 0;
+    long live = 0;
+};
+
+extern ArenaStats arenaStats;
+
+// Fixed-size slots cut from slabs aligned to their own size. A slab starts with a pointer to its
+// arena, so a slot is freed from its address alone and never moves while it is live
+class SlotArena {
+private:
+    size_t slotSize;
+    std::vector<char *> slabs;
+    void *freeList = nullptr;
+    char *next = nullptr;
+    char *end = nullptr;
+    long live = 0;
+
+    void addSlab();
+
+public:
+    void *allocate(size_t size);
+    static void free(void *slot);
+    // Forgets every slot without running destructors, the first slab is kept for the next level
+    void release();
+    long liveCount() const { return live; }
+    size_t slabCount() const { return slabs.size(); }
+
+    explicit SlotArena(size_t slotSize);
+    SlotArena(const SlotArena&) = delete;
+    SlotArena& operator=(const SlotArena&) = delete;
+    ~SlotArena();
+};
+
+// Every monster and object of one level
+class LevelArena {
+public:
+    SlotArena monsters;
+    SlotArena objects;
+
+    // Drops the whole level at once. The grids and lists that pointed into it must let go first
+    void release();
+
+    LevelArena();
+};
+
+// New monsters and objects go to the level being played unless placement new names another arena,
+// a level left behind takes its arena along
+extern std::unique_ptr<LevelArena> levelArena;
+// What the player carries outlives every level
+extern std::unique_ptr<LevelArena> playerArena;
+
+// Hands over the current level's arena and starts an empty one in its place
+std::unique_ptr<LevelArena> takeLevelArena();
+void printArenaStats();
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <vector>
+
+#include "dungeon.hpp"
+
+// Everything on the dungeon floor, in player distance order as of the last sortRosters
+extern std::vector<Monster *> monsterRoster;
+extern std::vector<Object *> objectRoster;
+
+void sortRosters(Pos from);
+void clearRosters();
+int monsterRowCount(Monster *mon);
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <vector>
+
+#include "dungeon.hpp"
+
+// FLOOR cells grouped by the room they lie in, with one last group for floor outside every room.
+// Spawners draw from it instead of guessing coordinates, and a cell that fills up is taken out in
+// O(1) by moving the last cell of its group into its place
+class FloorIndex {
+private:
+    std::vector<std::vector<Pos>> groups;
+    // Per cell, its place in its group or -1 once taken out, and the group of the room around it
+    Grid<int> slot;
+    Grid<int> groupOf;
+
+public:
+    // outside adds the floor that is in no room as the last group
+    void build(std::vector<Room>& fromRooms, bool outside);
+    void remove(Pos pos);
+    int groupCount() const { return groups.size(); }
+    // The room group a cell lies in, or -1
+    int groupAt(Pos pos) const;
+    // Uniform over the cells left in the allowed groups, {-1, -1} if there are none
+    Pos sample(const std::vector<bool>& allowed) const;
+};
@@ -1,4 +1,8 @@
 #pragma once
 
+// BASE_VISION_RADIUS plus the equipped light, worked out once for a loop over many cells
+int visionRadius();
 bool inLineOfSight(Pos pos);
+bool inLineOfSight(Pos pos, int radius);
+void updateAroundPlayer();
 int playGame();
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "dungeon.hpp"
+
+// Carves rooms and corridors into a level that initDungeon has already filled with rock and
+// hardness. Every engine fills rooms and roomCount the same way, stairs are placed afterwards
+class Generator {
+public:
+    virtual const char *getName() const = 0;
+    virtual void generate() = 0;
+    virtual ~Generator() = default;
+};
+
+// Random rooms joined in placement order by wandering corridors
+class RandomWalkGenerator : public Generator {
+public:
+    const char *getName() const override { return "rooms"; }
+    void generate() override;
+};
+
+// Splits the map into leaves, one room per leaf, and joins sibling subtrees
+class BspGenerator : public Generator {
+private:
+    int split(int x, int y, int width, int height);
+
+public:
+    const char *getName() const override { return "bsp"; }
+    void generate() override;
+};
+
+// Random rooms joined along a minimum spanning tree of their centers
+class MstGenerator : public Generator {
+public:
+    const char *getName() const override { return "mst"; }
+    void generate() override;
+};
+
+// Cellular automata caves on bit rows, one bit per cell with 1 for rock
+class CaveGenerator : public Generator {
+private:
+    // 64 bit words per row
+    int words;
+    Grid<uint64_t> cells;
+
+    void seed();
+    void smooth();
+    int keepLargestRegion();
+    void claimRooms();
+
+public:
+    const char *getName() const override { return "cave"; }
+    void generate() override;
+};
+
+extern std::unique_ptr<Generator> generator;
+
+// Returns nullptr for an unknown name
+std::unique_ptr<Generator> makeGenerator(const char *name);
+int generatorBenchmark(int levels);
+// Times hardness, structures, spawning, one distance field and FOV per level at the current size
+int scaleBenchmark(int levels);
+// Open cells reachable from the up staircase
+int reachableCells();
+// Mixes a game seed and a level number into the srand seed for that level
+unsigned int levelSeed(unsigned int seed, int level);
@@ -8,4 +8,8 @@ extern bool supportsColor;
 extern int numMonsters;
 extern int numObjects;
 
+extern unsigned int gameSeed;
+
 extern bool fogOfWarToggle;
+
+extern unsigned int animationTick;
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <vector>
+
+// A width x height map in one row-major block. grid[y][x] indexes like the fixed arrays it replaced
+template <typename T>
+class Grid {
+private:
+    int width = 0;
+    int height = 0;
+    std::vector<T> cells;
+    // cells.data(), kept so indexing stays cheap in unoptimized builds
+    T *base = nullptr;
+
+public:
+    void resize(int newWidth, int newHeight, const T& value = T()) {
+        width = newWidth;
+        height = newHeight;
+        cells.clear();
+        cells.resize(static_cast<size_t>(width) * height, value);
+        base = cells.data();
+    }
+
+    void fill(const T& value) {
+        for (T& cell : cells) {
+            cell = value;
+        }
+    }
+
+    [[gnu::always_inline]] T *operator[](int y) { return base + static_cast<size_t>(y) * width; }
+    [[gnu::always_inline]] const T *operator[](int y) const { return base + static_cast<size_t>(y) * width; }
+
+    T *data() { return cells.data(); }
+    const T *data() const { return cells.data(); }
+    size_t size() const { return cells.size(); }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+    Grid() = default;
+    Grid(int width, int height, const T& value = T()) { resize(width, height, value); }
+    // A copy would share base with the original
+    Grid(const Grid&) = delete;
+    Grid& operator=(const Grid&) = delete;
+    Grid(Grid&&) = default;
+    Grid& operator=(Grid&&) = default;
+};
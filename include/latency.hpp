@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+static const int DEFAULT_LATENCY_BITS = 8;
+
+// Log-linear buckets in the style of HdrHistogram: values below 2^bits are exact, above that
+// every power of two is split into 2^(bits-1) buckets, so the relative error stays under 2^-(bits-1)
+class LatencyHistogram {
+private:
+    int bits;
+    std::vector<uint64_t> counts;
+    uint64_t total;
+    int64_t max;
+
+    int bucketOf(int64_t value) const;
+    int64_t highestInBucket(int index) const;
+
+public:
+    void record(int64_t value);
+    int64_t percentile(double p) const;
+    uint64_t getTotal() const { return total; }
+    int64_t getMax() const { return max; }
+
+    LatencyHistogram(int bits);
+    LatencyHistogram() = delete;
+    ~LatencyHistogram() = default;
+};
+
+// Records the lifetime of its scope into a histogram, or does nothing when given nullptr
+class LatencyTimer {
+private:
+    LatencyHistogram *histogram;
+    int64_t start;
+
+public:
+    LatencyTimer(LatencyHistogram *histogram);
+    LatencyTimer() = delete;
+    ~LatencyTimer();
+};
+
+extern bool latencyEnabled;
+
+bool startLatency(const char *filename, int bits, int monsterTypes);
+void stopLatency();
+LatencyHistogram *playerTurnLatency();
+LatencyHistogram *monsterTurnLatency(int monTypeIndex);
+void inputReceived();
+void levelTransitionStarted();
+void frameCompleted();
+void checkLatencyDump();
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dungeon.hpp"
+
+static const size_t DEFAULT_LEVEL_CACHE_KB = 512;
+
+// A tile that changed since generation, the generated values are kept to rebuild the baseline
+class TileDiff {
+public:
+    uint32_t index;
+    char type;
+    uint8_t hardness;
+    char baseType;
+    uint8_t baseHardness;
+};
+
+// A level the player has left, with its entities moved out of the grids along with the arena
+// that holds them
+class LevelState {
+public:
+    int depth;
+    bool regenerable;
+    std::vector<Tile> tiles;
+    // Changes since generation, all that goes to disk for a level that can be regenerated
+    std::vector<TileDiff> terrainDiff;
+    std::vector<Room> rooms;
+    std::vector<Pos> upStairs;
+    std::vector<Pos> downStairs;
+    // Held by the arena below
+    std::vector<Monster *> monsters;
+    std::vector<Object *> objects;
+    std::unique_ptr<LevelArena> arena;
+
+    size_t bytes() const;
+
+    LevelState() = default;
+    LevelState(LevelState&&) = default;
+    LevelState& operator=(LevelState&&) = default;
+    // Frees the entities together with their arena
+    ~LevelState();
+};
+
+extern int depth;
+
+// Raw bytes of a value appended to a buffer, read back in the same order
+template <typename T>
+void put(std::vector<char>& out, const T& value) {
+    const char *bytes = reinterpret_cast<const char *>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+bool take(const std::vector<char>& in, size_t& at, T& value) {
+    if (at + sizeof(T) > in.size()) {
+        return false;
+    }
+    memcpy(&value, in.data() + at, sizeof(T));
+    at += sizeof(T);
+    return true;
+}
+
+// Deflates a buffer to a file, and inflates it back and removes the file
+bool writePacked(const std::string& path, const std::vector<char>& raw);
+bool readPacked(const std::string& path, std::vector<char>& raw);
+
+void setLevelCacheLimit(size_t bytes);
+// Seeds rand() from the game seed and depth, so the terrain that follows is always the same
+void seedLevel(int levelDepth);
+// Remembers the freshly generated terrain, later diffs are taken against it
+void markGeneratedLevel(bool regenerable);
+// Stashes the current level and clears the globals for the next one
+void leaveLevel();
+// Restores a visited level or generates and populates a new one, arriving on the stairs
+void enterLevel(int levelDepth, bool fromAbove);
+// Starts generating the levels above and below in child processes, so taking the stairs only
+// swaps in the prepared level
+void prepareNeighbors();
+void clearLevelCache();
@@ -0,0 +1,18 @@
+#pragma once
+
+enum class Overlay {
+    None,
+    NonTunneling,
+    Tunneling,
+    Hardness,
+    Fov,
+    Rooms,
+    Corridors
+};
+
+// Debug views drawn in place of the map by printDungeon, the game keeps running underneath
+extern Overlay activeOverlay;
+
+void toggleOverlay(Overlay overlay);
+const char *overlayName(Overlay overlay);
+void drawOverlay();
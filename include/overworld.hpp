@@ -0,0 +1,33 @@
+#pragma once
+
+#include <vector>
+
+#include "dungeon.hpp"
+
+// Chunks are square, the map holds a window of WINDOW_CHUNKS x WINDOW_CHUNKS of them around the player
+static const int CHUNK_SIZE = 64;
+static const int WINDOW_CHUNKS = 3;
+
+// A loaded or paged out piece of the world. Rooms and entities are kept in world coordinates, and
+// tiles hold the true terrain even where the window's edge is hardened
+class Chunk {
+public:
+    int cx;
+    int cy;
+    bool present = false;
+    std::vector<Tile> tiles;
+    std::vector<Room> rooms;
+    // In the window's arena while the chunk is loaded
+    std::vector<Monster *> monsters;
+    std::vector<Object *> objects;
+};
+
+extern bool overworldFlag;
+
+// Fills the window with the chunks around the world origin and puts the player in the middle one
+void startOverworld();
+// Once the player has left the middle chunk, pages the chunks that fall out of the window to disk,
+// loads or generates the ones coming in and shifts everything so the player is in the middle again.
+// Returns false if the player is still in the middle chunk
+bool recenterOverworld();
+void clearOverworld();
@@ -1,9 +1,12 @@
 #pragma once
 
+#include <cstdlib>
 #include <set>
 #include <string>
 #include <vector>
 
+#include "prototype.hpp"
+
 class Dice {
 public:
     int base;
@@ -13,6 +16,8 @@ public:
     Dice(int base, int rolls, int sides) : base(base), rolls(rolls), sides(sides) {}
     Dice() : base(0), rolls(0), sides(0) {}
     ~Dice() = default;
+
+    int roll() const { return base + rolls * (rand() % sides + 1); }
 };
 
 class MonsterType {
@@ -28,6 +33,9 @@ public:
     int rarity;
     bool eligible = true;
 
+    // Filled in once the description is complete
+    MonsterPrototype proto;
+
     bool valid = true;
     std::set<std::string> fields;
 
@@ -53,6 +61,8 @@ public:
     int rarity;
     bool eligible = true;
 
+    ObjectPrototype proto;
+
     bool valid = true;
     std::set<std::string> fields;
 
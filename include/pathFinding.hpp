@@ -2,4 +2,20 @@
 
 #include "dungeon.hpp"
 
-int generateDistances(Pos pos);
+class DistanceField {
+public:
+    bool valid = false;
+    Pos source;
+    unsigned int terrainVersion;
+    Grid<int> tunneling;
+    Grid<int> nonTunneling;
+
+    const Grid<int>& forMonster(Monster *mon) const { return mon->isTunneling() ? tunneling : nonTunneling; }
+};
+
+// Bump whenever hardness or tile types change so cached distance fields are recomputed
+extern unsigned int terrainVersion;
+
+const DistanceField& distancesFrom(Pos pos);
+// distancesFrom for the monster AI, timed and counted as its pathfinding phase
+const DistanceField& generateDistances(Pos pos);
@@ -1,3 +1,19 @@
 #pragma once
 
+#include <vector>
+
+// Octaves of Perlin noise summed into hardness, each at twice the frequency and half the weight
+static const int HARDNESS_OCTAVES = 3;
+
+// Fills the map with hardness from a single rand() draw used as the noise seed
 void generateHardness();
+// Fills a width x height block of the map at x, y with the hardness of the world block whose top left
+// is worldX, worldY. Gradients are hashed from the seed and lattice point rather than stored, so the
+// same seed gives the same field at any map size and blocks generated apart line up at their edges
+void generateHardnessAt(unsigned int seed, int worldX, int worldY, int x, int y, int width, int height);
+
+// The row kernels this machine can run, slowest first, and the one in use. Every kernel produces the
+// same hardness
+std::vector<const char *> noisePaths();
+bool useNoisePath(const char *name);
+const char *noisePath();
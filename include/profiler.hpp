@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+
+#include "trace.hpp"
+
+enum class Phase {
+    SchedulerPop,
+    MonsterAI,
+    Pathfinding,
+    CheckCorridor,
+    Fov,
+    PrintDungeon,
+    Refresh,
+    Count
+};
+
+enum class Counter {
+    PathfindingCalls,
+    DistanceFieldBuilds,
+    HeapOps,
+    CursesCalls,
+    Count
+};
+
+static const int PHASE_COUNT = static_cast<int>(Phase::Count);
+static const int COUNTER_COUNT = static_cast<int>(Counter::Count);
+
+class PhaseStats {
+public:
+    long calls = 0;
+    int64_t nanos = 0;
+};
+
+// Running totals for the turn in progress, rolled over by endTurn
+extern PhaseStats phaseTurn[PHASE_COUNT];
+extern long counterTurn[COUNTER_COUNT];
+extern bool statsOverlayToggle;
+
+const char *phaseName(Phase phase);
+
+// Times its scope and traces it as a span; phases nest, so an outer phase includes its inner ones
+class PhaseProbe {
+private:
+    Phase phase;
+    int64_t start;
+
+public:
+    PhaseProbe(Phase phase) : phase(phase), start(monotonicNanos()) {}
+    PhaseProbe() = delete;
+    ~PhaseProbe() {
+        int64_t end = monotonicNanos();
+        PhaseStats& stats = phaseTurn[static_cast<int>(phase)];
+        stats.calls++;
+        stats.nanos += end - start;
+        if (tracing) {
+            traceSpan(phaseName(phase), "phase", start, end);
+        }
+    }
+};
+
+inline void countEvent(Counter counter, long n = 1) {
+    counterTurn[static_cast<int>(counter)] += n;
+}
+
+void endTurn();
+void toggleStatsOverlay();
+void drawStatsOverlay();
+void printStats();
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+enum class Color {
+    Default,
+    Black,
+    Red,
+    Green,
+    Yellow,
+    Blue,
+    Magenta,
+    Cyan,
+    White
+};
+
+enum class Equip {
+    Weapon,
+    Offhand,
+    Ranged,
+    Armor,
+    Helmet,
+    Cloak,
+    Gloves,
+    Boots,
+    Amulet,
+    Light,
+    Ring1,
+    Ring2,
+    Count,
+    None
+};
+
+// The first TYPE an object lists
+enum class ObjectKind {
+    Weapon,
+    Offhand,
+    Ranged,
+    Armor,
+    Helmet,
+    Cloak,
+    Gloves,
+    Boots,
+    Ring,
+    Amulet,
+    Light,
+    Scroll,
+    Book,
+    Flask,
+    Gold,
+    Ammunition,
+    Food,
+    Wand,
+    Container,
+    Unknown
+};
+
+// Monster ABIL keywords as bits
+enum Ability : unsigned int {
+    ABIL_SMART = 1u << 0,
+    ABIL_TELE = 1u << 1,
+    ABIL_TUNNEL = 1u << 2,
+    ABIL_ERRATIC = 1u << 3,
+    ABIL_PASS = 1u << 4,
+    ABIL_PICKUP = 1u << 5,
+    ABIL_DESTROY = 1u << 6,
+    ABIL_UNIQ = 1u << 7,
+    ABIL_BOSS = 1u << 8
+};
+
+// What a monster description compiles to once it is parsed, so spawning compares no strings
+class MonsterPrototype {
+public:
+    std::vector<Color> colors;
+    unsigned int abilities = 0;
+};
+
+class ObjectPrototype {
+public:
+    std::vector<Color> colors;
+    ObjectKind kind = ObjectKind::Unknown;
+    bool twoHanded = false;
+    char symbol = '*';
+    Equip equip = Equip::None;
+    std::string typeString;
+};
+
+std::vector<Color> compileColors(const std::vector<std::string>& names);
+unsigned int compileAbilities(const std::vector<std::string>& names);
+ObjectPrototype compileObjectTypes(const std::vector<std::string>& types, const std::vector<std::string>& colors);
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+static const size_t RING_CAPACITY = 1 << 20;
+
+// Single producer (game loop), single consumer (recorder thread), never blocks either side
+class FrameRing {
+private:
+    std::unique_ptr<char[]> buffer;
+    std::atomic<size_t> head;
+    std::atomic<size_t> tail;
+
+    void copyIn(size_t at, const void *src, size_t len);
+    void copyOut(size_t at, void *dst, size_t len);
+
+public:
+    // Drops the whole frame and returns false when it does not fit
+    bool push(double time, const char *data, uint32_t len);
+    bool pop(double& time, std::vector<char>& data);
+
+    FrameRing();
+    ~FrameRing() = default;
+};
+
+class Recorder {
+private:
+    FrameRing ring;
+    int fileFd;
+    int listenFd;
+    std::vector<int> clients;
+    std::thread writer;
+    std::atomic<bool> running;
+    std::atomic<bool> keyframeRequested;
+
+    void run();
+    void acceptClients();
+    void sendEvent(double time, const std::vector<char>& data);
+    void sendAll(int fd, const char *data, size_t len, bool isClient);
+
+public:
+    std::atomic<long> framesDropped;
+
+    void recordFrame(double time, const char *data, size_t len);
+    bool takeKeyframeRequest();
+    void stop();
+
+    Recorder(int fileFd, int listenFd);
+    Recorder() = delete;
+    ~Recorder();
+};
+
+extern std::unique_ptr<Recorder> recorder;
+
+bool startRecording(const char *filename, const char *socketPath);
+void recordFrame(const char *data, size_t len);
+void stopRecording();
+int spectate(const char *socketPath);
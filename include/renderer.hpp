@@ -0,0 +1,96 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dungeon.hpp"
+
+static const int SCREEN_ROWS = VIEW_HEIGHT + 3;
+static const int SCREEN_COLS = VIEW_WIDTH;
+// The viewport scrolls once the focus gets this close to its edge
+static const int VIEW_MARGIN_X = 20;
+static const int VIEW_MARGIN_Y = 5;
+
+// The dungeon cell drawn at the top left of the map area
+extern Pos viewOrigin;
+// Scrolls the viewport to keep focus away from its edges, returns whether it moved
+bool scrollViewport(Pos focus);
+
+class RenderStats {
+public:
+    long presents = 0;
+    long bytesWritten = 0;
+    long writeCalls = 0;
+};
+
+// Everything the map view draws goes through here, menus still talk to ncurses directly
+class Renderer {
+public:
+    virtual void drawChar(int y, int x, char ch, Color color) = 0;
+    // Takes dungeon coordinates, shifts them by the viewport and drops cells outside the map area
+    void drawMapChar(int y, int x, char ch, Color color);
+    virtual int drawText(int y, int x, const char *text, Color color) = 0;
+    virtual void clearToEol(int y, int x) = 0;
+    virtual void present() = 0;
+    // The terminal was painted behind the renderer's back (clear(), full screen views)
+    virtual void invalidate() = 0;
+    virtual const char *getName() = 0;
+
+    RenderStats stats;
+
+    virtual ~Renderer() = default;
+};
+
+class NcursesRenderer : public Renderer {
+public:
+    void drawChar(int y, int x, char ch, Color color) override;
+    int drawText(int y, int x, const char *text, Color color) override;
+    void clearToEol(int y, int x) override;
+    void present() override;
+    void invalidate() override {}
+    const char *getName() override { return "ncurses"; }
+};
+
+class AnsiRenderer : public Renderer {
+private:
+    class Cell {
+    public:
+        char ch;
+        Color color;
+
+        bool operator==(const Cell& other) const {
+            return ch == other.ch && color == other.color;
+        }
+        bool operator!=(const Cell& other) const {
+            return !(*this == other);
+        }
+    };
+
+    int fd;
+    bool hosted;
+    std::vector<Cell> front;
+    std::vector<Cell> back;
+    std::string out;
+
+    void appendMove(int y, int x, int curY, int curX, Color curColor);
+    void appendColor(Color color);
+    void flush();
+
+public:
+    void drawChar(int y, int x, char ch, Color color) override;
+    int drawText(int y, int x, const char *text, Color color) override;
+    void clearToEol(int y, int x) override;
+    void present() override;
+    void invalidate() override;
+    const char *getName() override { return "ansi"; }
+
+    // hosted: ncurses owns the terminal too and must be kept in sync with what is written
+    AnsiRenderer(int fd, bool hosted);
+    AnsiRenderer() = delete;
+    ~AnsiRenderer() = default;
+};
+
+extern std::unique_ptr<Renderer> renderer;
+
+int renderBenchmark(int frames);
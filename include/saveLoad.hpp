@@ -2,3 +2,5 @@
 
 int loadDungeon(char *filename);
 int saveDungeon(char *filename);
+// Writes the same format to an exact path instead of one under ../data
+int writeDungeon(const char *path);
@@ -0,0 +1,11 @@
+#pragma once
+
+// Picks a spawnable type in constant time from an alias table over the parsed types. Each eligible,
+// valid type is weighted by the odds its rarity roll used to give it, so the mix is what rejection
+// sampling produced. Returns -1 if no type can spawn
+int pickMonsterType();
+int pickObjectType();
+
+// Uniques and artifacts leave the pool once placed. The table is rebuilt on the next pick after a change
+void setMonsterEligible(int index, bool eligible);
+void setObjectEligible(int index, bool eligible);
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+
+static const size_t TRACE_RING_EVENTS = 1 << 16;
+
+inline int64_t monotonicNanos() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Names and categories must be string literals or otherwise outlive the trace, only the pointer is kept
+class TraceEvent {
+public:
+    const char *name;
+    const char *category;
+    int64_t start;
+    int64_t end;
+};
+
+// Written only by its own thread; once it wraps the oldest spans are overwritten
+class TraceBuffer {
+public:
+    int tid;
+    const char *threadName;
+    std::unique_ptr<TraceEvent[]> events;
+    size_t pushed;
+
+    void push(const char *name, const char *category, int64_t start, int64_t end);
+
+    TraceBuffer(int tid);
+    TraceBuffer() = delete;
+    ~TraceBuffer() = default;
+};
+
+extern bool tracing;
+
+bool startTracing(const char *filename);
+void stopTracing();
+void nameTraceThread(const char *name);
+void traceSpan(const char *name, const char *category, int64_t start, int64_t end);
+
+class TraceSpan {
+private:
+    const char *name;
+    const char *category;
+    int64_t start;
+
+public:
+    TraceSpan(const char *name, const char *category) : name(name), category(category), start(tracing ? monotonicNanos() : 0) {}
+    TraceSpan() = delete;
+    ~TraceSpan() {
+        if (tracing) {
+            traceSpan(name, category, start, monotonicNanos());
+        }
+    }
+};
@@ -0,0 +1,225 @@
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <poll.h>
+#include <string>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+#include "corpus.hpp"
+#include "dungeon.hpp"
+#include "generator.hpp"
+#include "globals.hpp"
+#include "pathFinding.hpp"
+#include "saveLoad.hpp"
+#include "spawnTable.hpp"
+
+static std::string levelPath(const char *outDir, int level) {
+    char name[32];
+    snprintf(name, sizeof(name), "/level-%06d.rlg327", level);
+    return std::string(outDir) + name;
+}
+
+static LevelStats measureLevel(int level, unsigned int seed) {
+    LevelStats stats = {level, seed, static_cast<int>(rooms.size()), 0, 0, reachableCells(), -1};
+    for (int y = 0; y < dungeonHeight; y++) {
+        for (int x = 0; x < dungeonWidth; x++) {
+            stats.openCells += dungeon[y][x].type != ROCK;
+            stats.corridorCells += dungeon[y][x].type == CORRIDOR;
+        }
+    }
+
+    Pos down = downStairs.back();
+    int distance = distancesFrom(upStairs.back()).nonTunneling[down.y][down.x];
+    if (distance != UNREACHABLE) {
+        stats.stairDistance = distance;
+    }
+    return stats;
+}
+
+// Runs in a forked child, so it owns its copy of the dungeon globals and of rand()
+static void runWorker(int worker, int levels, int workers, unsigned int seed, const char *outDir, int out) {
+    // Unique monsters and artifacts stay spawnable on every level, so a level never depends on
+    // which levels the same worker happened to generate before it
+    std::vector<bool> monsterEligible, objectEligible;
+    for (const MonsterType& type : monsterTypeList) {
+        monsterEligible.push_back(type.eligible);
+    }
+    for (const ObjectType& type : objectTypeList) {
+        objectEligible.push_back(type.eligible);
+    }
+
+    for (int level = worker; level < levels; level += workers) {
+        for (size_t i = 0; i < monsterTypeList.size(); i++) {
+            setMonsterEligible(i, monsterEligible[i]);
+        }
+        for (size_t i = 0; i < objectTypeList.size(); i++) {
+            setObjectEligible(i, objectEligible[i]);
+        }
+
+        unsigned int levelRandSeed = levelSeed(seed, level);
+        clearAll();
+        srand(levelRandSeed);
+        initDungeon();
+        generateStructures();
+        spawnPlayer();
+        spawnMonsters(numMonsters, player.getPos().x, player.getPos().y);
+        spawnObjects(numObjects);
+
+        if (writeDungeon(levelPath(outDir, level).c_str())) {
+            fprintf(stderr, "Error: Cannot write %s\n", levelPath(outDir, level).c_str());
+            _exit(1);
+        }
+        LevelStats stats = measureLevel(level, levelRandSeed);
+        if (write(out, &stats, sizeof(stats)) != sizeof(stats)) {
+            _exit(1);
+        }
+    }
+    _exit(0);
+}
+
+// Used when the workers cannot all be started, those that were are stopped rather than left writing
+// into the corpus on their own
+static void stopWorkers(const std::vector<pid_t>& pids, const std::vector<int>& pipes) {
+    for (int fd : pipes) {
+        close(fd);
+    }
+    for (pid_t pid : pids) {
+        kill(pid, SIGTERM);
+    }
+    for (pid_t pid : pids) {
+        waitpid(pid, nullptr, 0);
+    }
+}
+
+int generateCorpus(int levels, int workers, unsigned int seed, const char *outDir) {
+    if (mkdir(outDir, 0755) != 0 && errno != EEXIST) {
+        printf("Error: Cannot create directory %s\n", outDir);
+        return 1;
+    }
+    if (workers > levels) {
+        workers = levels;
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    fflush(stdout);
+    fflush(stderr);
+
+    // Generation is built on process wide state (the dungeon globals and rand()), so the workers
+    // are processes rather than threads and report back over a pipe each
+    std::vector<pid_t> pids;
+    std::vector<int> pipes;
+    for (int worker = 0; worker < workers; worker++) {
+        int fds[2];
+        if (pipe(fds) != 0) {
+            perror("pipe");
+            stopWorkers(pids, pipes);
+            return 1;
+        }
+        pid_t pid = fork();
+        if (pid == -1) {
+            perror("fork");
+            close(fds[0]);
+            close(fds[1]);
+            stopWorkers(pids, pipes);
+            return 1;
+        }
+        if (pid == 0) {
+            close(fds[0]);
+            runWorker(worker, levels, workers, seed, outDir, fds[1]);
+        }
+        close(fds[1]);
+        pids.push_back(pid);
+        pipes.push_back(fds[0]);
+    }
+
+    // Every pipe is drained as it fills, a worker left waiting on a full pipe would stall the run
+    std::vector<LevelStats> index(levels);
+    std::vector<bool> done(levels, false);
+    std::vector<std::vector<char>> pending(workers);
+    std::vector<pollfd> reading;
+    for (int worker = 0; worker < workers; worker++) {
+        reading.push_back((pollfd){pipes[worker], POLLIN, 0});
+    }
+    while (!reading.empty()) {
+        if (poll(reading.data(), reading.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            perror("poll");
+            // Closing the rest lets their workers fail instead of waiting forever
+            for (pollfd& fd : reading) {
+                close(fd.fd);
+            }
+            break;
+        }
+        for (size_t i = 0; i < reading.size();) {
+            if (reading[i].revents == 0) {
+                i++;
+                continue;
+            }
+            int worker = std::find(pipes.begin(), pipes.end(), reading[i].fd) - pipes.begin();
+            char buffer[4096];
+            ssize_t got = read(reading[i].fd, buffer, sizeof(buffer));
+            if (got <= 0) {
+                close(reading[i].fd);
+                reading.erase(reading.begin() + i);
+                continue;
+            }
+            // A record can arrive split across reads, whole ones are filed by level
+            std::vector<char>& bytes = pending[worker];
+            bytes.insert(bytes.end(), buffer, buffer + got);
+            size_t whole = bytes.size() / sizeof(LevelStats) * sizeof(LevelStats);
+            for (size_t at = 0; at < whole; at += sizeof(LevelStats)) {
+                LevelStats stats;
+                memcpy(&stats, bytes.data() + at, sizeof(stats));
+                index[stats.level] = stats;
+                done[stats.level] = true;
+            }
+            bytes.erase(bytes.begin(), bytes.begin() + whole);
+            reading[i].revents = 0;
+            i++;
+        }
+    }
+
+    int status = 0;
+    for (int worker = 0; worker < workers; worker++) {
+        int exitStatus;
+        waitpid(pids[worker], &exitStatus, 0);
+        if (!WIFEXITED(exitStatus) || WEXITSTATUS(exitStatus) != 0) {
+            status = 1;
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    std::string indexPath = std::string(outDir) + "/index.tsv";
+    FILE *file = fopen(indexPath.c_str(), "w");
+    if (file == nullptr) {
+        printf("Error: Cannot write %s\n", indexPath.c_str());
+        return 1;
+    }
+    fprintf(file, "level\tseed\trooms\tcorridor_cells\topen_cells\treachable_cells\tstair_distance\tgenerator\n");
+    for (int level = 0; level < levels; level++) {
+        if (!done[level]) {
+            status = 1;
+            continue;
+        }
+        const LevelStats& stats = index[level];
+        fprintf(file, "%d\t%u\t%d\t%d\t%d\t%d\t%d\t%s\n", stats.level, stats.seed, stats.rooms, stats.corridorCells,
+                stats.openCells, stats.reachableCells, stats.stairDistance, generator->getName());
+    }
+    fclose(file);
+
+    printf("Generated %d levels with %d workers in %.2f s (%.0f levels/s) into %s\n", levels, workers, seconds,
+           levels / seconds, outDir);
+    if (status != 0) {
+        printf("Error: Some workers failed, the index is missing levels\n");
+    }
+    return status;
+}
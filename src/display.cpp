@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cmath>
 #include <cstdarg>
 #include <cstdio>
@@ -14,9 +15,13 @@
 
 #include "display.hpp"
 #include "dungeon.hpp"
+#include "entityList.hpp"
 #include "game.hpp"
 #include "globals.hpp"
+#include "overlay.hpp"
 #include "pathFinding.hpp"
+#include "profiler.hpp"
+#include "renderer.hpp"
 
 class CommandInfo {
 public:
@@ -48,17 +53,41 @@ static const CommandInfo switches[] = {
     {"v", "View actions"},
     {"w", "Wear item"},
     {"x", "Expunge item"},
-    {"D", "Show mon-tunneling map"},
+    {"C", "Toggle corridor components"},
+    {"D", "Toggle non-tunneling map"},
     {"E", "Inspect equipment item"},
+    {"F", "Toggle field of view"},
+    {"H", "Toggle hardness map"},
     {"I", "Inspect inventory item"},
     {"L", "Look at monster"},
     {"Q", "Quit the game"},
-    {"T", "Show tunneling map"},
+    {"R", "Toggle room IDs"},
+    {"S", "Toggle frame timing stats"},
+    {"T", "Toggle tunneling map"},
     {"U", "Use item"},
     {",", "Pick up item"},
     {"?", "Show help"}
 };
 
+unsigned int animationTick = 0;
+
+// Cells holding a multi-colored entity as of the last printDungeon, the only ones redisplayColors repaints
+static std::vector<Pos> animatedCells;
+
+// Overlay windows drawn above stdscr, bottom to top
+static std::vector<WINDOW *> panelStack;
+
+void initColorPairs() {
+    init_pair(1, COLOR_WHITE, COLOR_BLACK);
+    init_pair(2, COLOR_RED, COLOR_BLACK);
+    init_pair(3, COLOR_GREEN, COLOR_BLACK);
+    init_pair(4, COLOR_YELLOW, COLOR_BLACK);
+    init_pair(5, COLOR_BLUE, COLOR_BLACK);
+    init_pair(6, COLOR_MAGENTA, COLOR_BLACK);
+    init_pair(7, COLOR_CYAN, COLOR_BLACK);
+    init_pair(8, COLOR_WHITE, COLOR_BLACK);
+}
+
 void printParsedMonsters() {
     std::cout << "MONSTER LIST:" << std::endl;
     for (const auto& m : monsterTypeList) {
@@ -126,70 +155,75 @@ void fitString(std::string& str, int maxWidth) {
 }
 
 void printLine(int line, const char* format, ...) {
-    char buffer[MAX_WIDTH];
+    char buffer[VIEW_WIDTH];
     va_list args;
     va_start(args, format);
-    vsnprintf(buffer, MAX_WIDTH + 2, format, args);
+    vsnprintf(buffer, VIEW_WIDTH + 2, format, args);
     va_end(args);
 
-    move(line, 0);
-    clrtoeol();
-
     int len = strlen(buffer);
-    if (len > MAX_WIDTH) {
-        if (buffer[MAX_WIDTH - 3] == ' ') {
-            buffer[MAX_WIDTH - 4] = '.';
-            buffer[MAX_WIDTH - 3] = '.';
-            buffer[MAX_WIDTH - 2] = '.';
-            buffer[MAX_WIDTH - 1] = '\0';
+    if (len > VIEW_WIDTH) {
+        if (buffer[VIEW_WIDTH - 3] == ' ') {
+            buffer[VIEW_WIDTH - 4] = '.';
+            buffer[VIEW_WIDTH - 3] = '.';
+            buffer[VIEW_WIDTH - 2] = '.';
+            buffer[VIEW_WIDTH - 1] = '\0';
         }
         else {
-            buffer[MAX_WIDTH - 3] = '.';
-            buffer[MAX_WIDTH - 2] = '.';
-            buffer[MAX_WIDTH - 1] = '.';
-            buffer[MAX_WIDTH] = '\0';
+            buffer[VIEW_WIDTH - 3] = '.';
+            buffer[VIEW_WIDTH - 2] = '.';
+            buffer[VIEW_WIDTH - 1] = '.';
+            buffer[VIEW_WIDTH] = '\0';
         }
     }
 
-    printw("%s", buffer);
-    refresh();
+    renderer->clearToEol(line, 0);
+    renderer->drawText(line, 0, buffer, Color::Default);
+    renderer->present();
 }
 
 void printLineColor(int line, Color color, const char* format, ...) {
-    char buffer[MAX_WIDTH];
+    char buffer[VIEW_WIDTH];
     va_list args;
     va_start(args, format);
-    vsnprintf(buffer, MAX_WIDTH + 2, format, args);
+    vsnprintf(buffer, VIEW_WIDTH + 2, format, args);
     va_end(args);
 
-    move(line, 0);
-    clrtoeol();
-
     int len = strlen(buffer);
-    if (len > MAX_WIDTH) {
-        if (buffer[MAX_WIDTH - 3] == ' ') {
-            buffer[MAX_WIDTH - 4] = '.';
-            buffer[MAX_WIDTH - 3] = '.';
-            buffer[MAX_WIDTH - 2] = '.';
-            buffer[MAX_WIDTH - 1] = '\0';
+    if (len > VIEW_WIDTH) {
+        if (buffer[VIEW_WIDTH - 3] == ' ') {
+            buffer[VIEW_WIDTH - 4] = '.';
+            buffer[VIEW_WIDTH - 3] = '.';
+            buffer[VIEW_WIDTH - 2] = '.';
+            buffer[VIEW_WIDTH - 1] = '\0';
         }
         else {
-            buffer[MAX_WIDTH - 3] = '.';
-            buffer[MAX_WIDTH - 2] = '.';
-            buffer[MAX_WIDTH - 1] = '.';
-            buffer[MAX_WIDTH] = '\0';
+            buffer[VIEW_WIDTH - 3] = '.';
+            buffer[VIEW_WIDTH - 2] = '.';
+            buffer[VIEW_WIDTH - 1] = '.';
+            buffer[VIEW_WIDTH] = '\0';
         }
     }
 
-    if (supportsColor) {
-        attron(COLOR_PAIR(color));
-        printw("%s", buffer);
-        attroff(COLOR_PAIR(color));
+    renderer->clearToEol(line, 0);
+    renderer->drawText(line, 0, buffer, supportsColor ? color : Color::Default);
+    renderer->present();
+}
+
+// Map cells only carry a color when the terminal can show one
+static Color shade(Color c) {
+    return supportsColor ? c : Color::Default;
+}
+
+static void drawAnimatedCell(Pos pos) {
+    if (monsterAt[pos.y][pos.x] != nullptr) {
+        Monster *mon = monsterAt[pos.y][pos.x];
+        renderer->drawMapChar(pos.y, pos.x, mon->getSymbol(), mon->getColor());
     }
-    else {
-        printw("%s", buffer);
+    else if (!objectsAt[pos.y][pos.x].empty() && !(pos == player.getPos())) {
+        Object *obj = objectsAt[pos.y][pos.x].back();
+        renderer->drawMapChar(pos.y, pos.x, objectsAt[pos.y][pos.x].size() > 1 ? '&' : obj->getSymbol(), obj->getColor());
     }
-    refresh();
 }
 
 void redisplayColors() {
@@ -197,61 +231,9 @@ void redisplayColors() {
         return;
     }
 
-    if (fogOfWarToggle) {
-        for (int y = 0; y < MAX_HEIGHT; y++) {
-            for (int x = 0; x < MAX_WIDTH; x++) {
-                if (inLineOfSight((Pos){x, y}) && (x != player.getPos().x || y != player.getPos().y)) {
-                    if (monsterAt[y][x] != nullptr) {
-                        Color c = monsterAt[y][x].get()->getColor();
-                        attron(COLOR_PAIR(c));
-                        mvaddch(y + 1, x, monsterAt[y][x].get()->getSymbol());
-                        attroff(COLOR_PAIR(c));
-                    }
-                    else if (!objectsAt[y][x].empty()) {
-                        Color c = objectsAt[y][x].back().get()->getColor();
-                        if (objectsAt[y][x].size() > 1) {
-                            attron(COLOR_PAIR(c));
-                            mvaddch(y + 1, x, '&');
-                            attroff(COLOR_PAIR(c));
-                        }
-                        else {
-                            attron(COLOR_PAIR(c));
-                            mvaddch(y + 1, x, objectsAt[y][x].back().get()->getSymbol());
-                            attroff(COLOR_PAIR(c));
-                        }
-                    }
-                }
-            }
-        }
-    }
-    else {
-        for (int y = 0; y < MAX_HEIGHT; y++) {
-            for (int x = 0; x < MAX_WIDTH; x++) {
-                if (x == player.getPos().x && y == player.getPos().y) {
-                    continue;
-                }
-
-                if (monsterAt[y][x] != nullptr) {
-                    Color c = monsterAt[y][x].get()->getColor();
-                    attron(COLOR_PAIR(c));
-                    mvaddch(y + 1, x, monsterAt[y][x].get()->getSymbol());
-                    attroff(COLOR_PAIR(c));
-                }
-                else if (!objectsAt[y][x].empty()) {
-                    Color c = objectsAt[y][x].back().get()->getColor();
-                    if (objectsAt[y][x].size() > 1) {
-                        attron(COLOR_PAIR(c));
-                        mvaddch(y + 1, x, '&');
-                        attroff(COLOR_PAIR(c));
-                    }
-                    else {
-                        attron(COLOR_PAIR(c));
-                        mvaddch(y + 1, x, objectsAt[y][x].back().get()->getSymbol());
-                        attroff(COLOR_PAIR(c));
-                    }
-                }
-            }
-        }
+    animationTick++;
+    for (const Pos& pos : animatedCells) {
+        drawAnimatedCell(pos);
     }
 }
 
@@ -260,69 +242,40 @@ void redisplayColorsOutsideWindow(int height, int width, int startY, int startX)
         return;
     }
 
-    if (fogOfWarToggle) {
-        for (int y = 0; y < MAX_HEIGHT; y++) {
-            for (int x = 0; x < MAX_WIDTH; x++) {
-                if (inLineOfSight((Pos){x, y}) && (x != player.getPos().x || y != player.getPos().y)) {
-                    if ((x >= startX && x < startX + width) && (y + 1 >= startY && y + 1 < startY + height)) {
-                        continue;
-                    }
-
-                    if (monsterAt[y][x] != nullptr) {
-                        Color c = monsterAt[y][x].get()->getColor();
-                        attron(COLOR_PAIR(c));
-                        mvaddch(y + 1, x, monsterAt[y][x].get()->getSymbol());
-                        attroff(COLOR_PAIR(c));
-                    }
-                    else if (!objectsAt[y][x].empty()) {
-                        Color c = objectsAt[y][x].back().get()->getColor();
-                        if (objectsAt[y][x].size() > 1) {
-                            attron(COLOR_PAIR(c));
-                            mvaddch(y + 1, x, '&');
-                            attroff(COLOR_PAIR(c));
-                        }
-                        else {
-                            attron(COLOR_PAIR(c));
-                            mvaddch(y + 1, x, objectsAt[y][x].back().get()->getSymbol());
-                            attroff(COLOR_PAIR(c));
-                        }
-                    }
-                }
-            }
+    animationTick++;
+    for (const Pos& pos : animatedCells) {
+        int screenX = pos.x - viewOrigin.x;
+        int screenY = pos.y - viewOrigin.y + 1;
+        if ((screenX >= startX && screenX < startX + width) && (screenY >= startY && screenY < startY + height)) {
+            continue;
         }
+        drawAnimatedCell(pos);
     }
-    else {
-        for (int y = 0; y < MAX_HEIGHT; y++) {
-            for (int x = 0; x < MAX_WIDTH; x++) {
-                if ((x >= startX && x < startX + width) && (y + 1 >= startY && y + 1 < startY + height)) {
-                    continue;
-                }
-                if (x == player.getPos().x && y == player.getPos().y) {
-                    continue;
-                }
+}
 
-                if (monsterAt[y][x] != nullptr) {
-                    Color c = monsterAt[y][x].get()->getColor();
-                    attron(COLOR_PAIR(c));
-                    mvaddch(y + 1, x, monsterAt[y][x].get()->getSymbol());
-                    attroff(COLOR_PAIR(c));
-                }
-                else if (!objectsAt[y][x].empty()) {
-                    Color c = objectsAt[y][x].back().get()->getColor();
-                    if (objectsAt[y][x].size() > 1) {
-                        attron(COLOR_PAIR(c));
-                        mvaddch(y + 1, x, '&');
-                        attroff(COLOR_PAIR(c));
-                    }
-                    else {
-                        attron(COLOR_PAIR(c));
-                        mvaddch(y + 1, x, objectsAt[y][x].back().get()->getSymbol());
-                        attroff(COLOR_PAIR(c));
-                    }
-                }
-            }
-        }
+WINDOW *openPanel(int height, int width, int startY, int startX) {
+    WINDOW *win = newwin(height, width, startY, startX);
+    keypad(win, TRUE);
+    panelStack.push_back(win);
+    return win;
+}
+
+void refreshPanels() {
+    wnoutrefresh(stdscr);
+    for (WINDOW *panel : panelStack) {
+        touchwin(panel);
+        wnoutrefresh(panel);
     }
+    doupdate();
+}
+
+void closePanel(WINDOW *win) {
+    panelStack.erase(std::find(panelStack.begin(), panelStack.end(), win));
+    delwin(win);
+
+    // stdscr still holds everything the panel covered, so restoring is a copy and a diff, not a redraw
+    touchwin(stdscr);
+    refreshPanels();
 }
 
 void characterInfo() {
@@ -331,7 +284,7 @@ void characterInfo() {
     printLine(MESSAGE_LINE, "Character Info:");
     printLine(STATUS_LINE1, "Press 'c' to return to the game.");
 
-    mvhline(1, 0, '.', MAX_WIDTH);
+    mvhline(1, 0, '.', VIEW_WIDTH);
 
     while (true) {
 
@@ -343,6 +296,7 @@ void characterInfo() {
         switch (ch) {
             case 'c':
             case 27:
+                renderer->invalidate();
                 printDungeon();
                 return;
         }
@@ -350,38 +304,38 @@ void characterInfo() {
 }
 
 void openEquipment() {
-    clear();
+    WINDOW *win = openPanel(0, 0, 0, 0);
 
-    printLine(MESSAGE_LINE, "Equipment:");
-    printLine(STATUS_LINE1, "Press 'e' to return to the game.");
+    mvwprintw(win, MESSAGE_LINE, 0, "Equipment:");
+    mvwprintw(win, STATUS_LINE1, 0, "Press 'e' to return to the game.");
 
-    mvhline(1, 0, '~', MAX_WIDTH - 1);
-    mvhline(MAX_HEIGHT, 0, '~', MAX_WIDTH - 1);
+    mvwhline(win, 1, 0, '~', VIEW_WIDTH - 1);
+    mvwhline(win, VIEW_HEIGHT, 0, '~', VIEW_WIDTH - 1);
 
-    mvaddch(1, 0, '*');
-    mvaddch(1, MAX_WIDTH - 1, '*');
-    mvaddch(MAX_HEIGHT, 0, '*');
-    mvaddch(MAX_HEIGHT, MAX_WIDTH - 1, '*');
+    mvwaddch(win, 1, 0, '*');
+    mvwaddch(win, 1, VIEW_WIDTH - 1, '*');
+    mvwaddch(win, VIEW_HEIGHT, 0, '*');
+    mvwaddch(win, VIEW_HEIGHT, VIEW_WIDTH - 1, '*');
 
     for (int i = 0; i < static_cast<int>(Equip::Count); i++) {
-        mvaddch(4, 1 + i * 3, ' ');
+        mvwaddch(win, 4, 1 + i * 3, ' ');
         if (player.getEquipmentItem((Equip)i) == nullptr) {
-            addch('.');
+            waddch(win, '.');
         }
         else {
             Color c = player.getEquipmentItem((Equip)i)->getColor();
             if (supportsColor) {
-                attron(COLOR_PAIR(c));
-                addch(player.getEquipmentItem((Equip)i)->getSymbol());
-                attroff(COLOR_PAIR(c));
+                wattron(win, COLOR_PAIR(c));
+                waddch(win, player.getEquipmentItem((Equip)i)->getSymbol());
+                wattroff(win, COLOR_PAIR(c));
             }
             else {
-                addch(player.getEquipmentItem((Equip)i)->getSymbol());
+                waddch(win, player.getEquipmentItem((Equip)i)->getSymbol());
             }
         }
-        addch(' ');
+        waddch(win, ' ');
 
-        mvaddch(5, 2 + i * 3, (char)('a' + i));
+        mvwaddch(win, 5, 2 + i * 3, (char)('a' + i));
     }
 
     std::vector<std::vector<std::string>> allLines;
@@ -432,7 +386,7 @@ void openEquipment() {
             }
 
             lines.push_back("Description: ");
-            std::string desc = player.getEquipmentItem((Equip)i)->getDescription();
+            const std::string& desc = player.getEquipmentItem((Equip)i)->getDescription();
             int j = 0;
             for (size_t i = 0; i < desc.length(); i++) {
                 if (desc[i] == '\n') {
@@ -444,53 +398,53 @@ void openEquipment() {
         allLines.push_back(lines);
     }
 
-    size_t maxDisplay = MAX_HEIGHT - 9;
+    size_t maxDisplay = VIEW_HEIGHT - 9;
     size_t topLine = 0;
     int cursor = 0;
 
     while (true) {
-        mvaddch(3, 2 + cursor * 3, 'v');
+        mvwaddch(win, 3, 2 + cursor * 3, 'v');
 
-        for (int i = 6; i < MAX_HEIGHT - 1; i++) {
-            move(i, 0);
-            clrtoeol();
+        for (int i = 6; i < VIEW_HEIGHT - 1; i++) {
+            wmove(win, i, 0);
+            wclrtoeol(win);
         }
-        mvprintw(6, 0, "Slot: %s", player.getEquipmentName(cursor));
+        mvwprintw(win, 6, 0, "Slot: %s", player.getEquipmentName(cursor));
 
-        move(7, 1);
-        clrtoeol();
+        wmove(win, 7, 1);
+        wclrtoeol(win);
         if (topLine > 0) {
-            addch('^');
+            waddch(win, '^');
         }
         else {
-            addch(' ');
+            waddch(win, ' ');
         }
 
         for (size_t i = 0; i < maxDisplay; i++) {
             int row = i + 8;
             size_t lineIndex = topLine + i;
 
-            move(row, 0);
-            clrtoeol();
+            wmove(win, row, 0);
+            wclrtoeol(win);
             if (lineIndex < allLines[cursor].size()) {
                 std::string line = allLines[cursor][lineIndex];
-                printw("%s", line.c_str());
+                wprintw(win, "%s", line.c_str());
             }
         }
-        move(MAX_HEIGHT - 1, 1);
+        wmove(win, VIEW_HEIGHT - 1, 1);
 
         if (topLine + maxDisplay < allLines[cursor].size()) {
-            addch('v');
+            waddch(win, 'v');
         }
         else {
-            addch(' ');
+            waddch(win, ' ');
         }
 
-        refresh();
+        wrefresh(win);
 
         int ch;
         do {
-            ch = getch();
+            ch = wgetch(win);
         } while (ch != KEY_RIGHT && ch != '6' && ch != 'l' &&
                  ch != KEY_LEFT && ch != '4' && ch != 'h' &&
                  ch != KEY_UP && ch != KEY_DOWN && ch != 'e' && ch != 27);
@@ -500,7 +454,7 @@ void openEquipment() {
             case '6':
             case 'l':
                 if (cursor < static_cast<int>(Equip::Count) - 1) {
-                    mvaddch(3, 2 + cursor * 3, ' ');
+                    mvwaddch(win, 3, 2 + cursor * 3, ' ');
                     cursor++;
                 }
                 break;
@@ -509,7 +463,7 @@ void openEquipment() {
             case '4':
             case 'h':
                 if (cursor > 0) {
-                    mvaddch(3, 2 + cursor * 3, ' ');
+                    mvwaddch(win, 3, 2 + cursor * 3, ' ');
                     cursor--;
                 }
                 break;
@@ -528,46 +482,45 @@ void openEquipment() {
 
             case 'e':
             case 27:
-                clear();
-                printDungeon();
+                closePanel(win);
                 return;
         }
     }
 }
 
 void openInventory() {
-    clear();
+    WINDOW *win = openPanel(0, 0, 0, 0);
 
-    printLine(MESSAGE_LINE, "Inventory:");
-    printLine(STATUS_LINE1, "Press 'i' to return to the game.");
+    mvwprintw(win, MESSAGE_LINE, 0, "Inventory:");
+    mvwprintw(win, STATUS_LINE1, 0, "Press 'i' to return to the game.");
 
-    mvhline(1, 0, '-', MAX_WIDTH - 1);
-    mvhline(MAX_HEIGHT, 0, '-', MAX_WIDTH - 1);
+    mvwhline(win, 1, 0, '-', VIEW_WIDTH - 1);
+    mvwhline(win, VIEW_HEIGHT, 0, '-', VIEW_WIDTH - 1);
 
-    mvaddch(1, 0, '+');
-    mvaddch(1, MAX_WIDTH - 1, '+');
-    mvaddch(MAX_HEIGHT, 0, '+');
-    mvaddch(MAX_HEIGHT, MAX_WIDTH - 1, '+');
+    mvwaddch(win, 1, 0, '+');
+    mvwaddch(win, 1, VIEW_WIDTH - 1, '+');
+    mvwaddch(win, VIEW_HEIGHT, 0, '+');
+    mvwaddch(win, VIEW_HEIGHT, VIEW_WIDTH - 1, '+');
 
     for (int i = 0; i < INVENTORY_SIZE; i++) {
-        mvaddch(4, 1 + i * 3, ' ');
+        mvwaddch(win, 4, 1 + i * 3, ' ');
         if (player.getInventoryItem(i) == nullptr) {
-            addch('.');
+            waddch(win, '.');
         }
         else {
             Color c = player.getInventoryItem(i)->getColor();
             if (supportsColor) {
-                attron(COLOR_PAIR(c));
-                addch(player.getInventoryItem(i)->getSymbol());
-                attroff(COLOR_PAIR(c));
+                wattron(win, COLOR_PAIR(c));
+                waddch(win, player.getInventoryItem(i)->getSymbol());
+                wattroff(win, COLOR_PAIR(c));
             }
             else {
-                addch(player.getInventoryItem(i)->getSymbol());
+                waddch(win, player.getInventoryItem(i)->getSymbol());
             }
         }
-        addch(' ');
+        waddch(win, ' ');
 
-        mvaddch(5, 2 + i * 3, (char)('0' + i));
+        mvwaddch(win, 5, 2 + i * 3, (char)('0' + i));
     }
 
     std::vector<std::vector<std::string>> allLines;
@@ -621,7 +574,7 @@ void openInventory() {
             }
 
             lines.push_back("Description: ");
-            std::string desc = player.getInventoryItem(i)->getDescription();
+            const std::string& desc = player.getInventoryItem(i)->getDescription();
             int j = 0;
             for (size_t i = 0; i < desc.length(); i++) {
                 if (desc[i] == '\n') {
@@ -633,52 +586,52 @@ void openInventory() {
         allLines.push_back(lines);
     }
 
-    size_t maxDisplay = MAX_HEIGHT - 9;
+    size_t maxDisplay = VIEW_HEIGHT - 9;
     size_t topLine = 0;
     int cursor = 0;
 
     while (true) {
-        mvaddch(3, 2 + cursor * 3, 'v');
+        mvwaddch(win, 3, 2 + cursor * 3, 'v');
 
-        for (int i = 6; i < MAX_HEIGHT - 1; i++) {
-            move(i, 0);
-            clrtoeol();
+        for (int i = 6; i < VIEW_HEIGHT - 1; i++) {
+            wmove(win, i, 0);
+            wclrtoeol(win);
         }
         
-        move(7, 1);
-        clrtoeol();
+        wmove(win, 7, 1);
+        wclrtoeol(win);
         if (topLine > 0) {
-            addch('^');
+            waddch(win, '^');
         }
         else {
-            addch(' ');
+            waddch(win, ' ');
         }
 
         for (size_t i = 0; i < maxDisplay; i++) {
             int row = i + 8;
             size_t lineIndex = topLine + i;
 
-            move(row, 0);
-            clrtoeol();
+            wmove(win, row, 0);
+            wclrtoeol(win);
             if (lineIndex < allLines[cursor].size()) {
                 std::string line = allLines[cursor][lineIndex];
-                printw("%s", line.c_str());
+                wprintw(win, "%s", line.c_str());
             }
         }
 
-        move(MAX_HEIGHT - 1, 1);
+        wmove(win, VIEW_HEIGHT - 1, 1);
         if (topLine + maxDisplay < allLines[cursor].size()) {
-            addch('v');
+            waddch(win, 'v');
         }
         else {
-            addch(' ');
+            waddch(win, ' ');
         }
 
-        refresh();
+        wrefresh(win);
 
         int ch;
         do {
-            ch = getch();
+            ch = wgetch(win);
         } while (ch != KEY_RIGHT && ch != '6' && ch != 'l' &&
                  ch != KEY_LEFT && ch != '4' && ch != 'h' && 
                  ch != KEY_UP && ch != KEY_DOWN && ch != 'i' && ch != 27);
@@ -688,7 +641,7 @@ void openInventory() {
             case '6':
             case 'l':
                 if (cursor < INVENTORY_SIZE - 1) {
-                    mvaddch(3, 2 + cursor * 3, ' ');
+                    mvwaddch(win, 3, 2 + cursor * 3, ' ');
                     cursor++;
                 }
                 break;
@@ -697,7 +650,7 @@ void openInventory() {
             case '4':
             case 'h':
                 if (cursor > 0) {
-                    mvaddch(3, 2 + cursor * 3, ' ');
+                    mvwaddch(win, 3, 2 + cursor * 3, ' ');
                     cursor--;
                 }
                 break;
@@ -716,380 +669,334 @@ void openInventory() {
 
             case 'i':
             case 27:
-                clear();
-                printDungeon();
+                closePanel(win);
                 return;
         }
     }
 }
 
 void printStatus() {
-    move(23, 0);
-    clrtoeol();
-    if (supportsColor) {
-        
-        printw("HP: ");
+    char buffer[VIEW_WIDTH];
+    renderer->clearToEol(23, 0);
 
-        double percent = static_cast<double>(player.getHitpoints()) / player.getMaxHitpoints();
-        if (percent >= 0.75) {
-            attron(COLOR_PAIR(Color::Green));
-            printw("%d/%d", player.getHitpoints(), player.getMaxHitpoints());
-            attroff(COLOR_PAIR(Color::Green));
-        }
-        else if (percent >= 0.25) {
-            attron(COLOR_PAIR(Color::Yellow));
-            printw("%d/%d", player.getHitpoints(), player.getMaxHitpoints());
-            attroff(COLOR_PAIR(Color::Yellow));
-        }
-        else {
-            attron(COLOR_PAIR(Color::Red));
-            printw("%d/%d", player.getHitpoints(), player.getMaxHitpoints());
-            attroff(COLOR_PAIR(Color::Red));
-        }
-        printw("   Speed: %d   Position: (%d, %d)", player.getSpeed(), player.getPos().x, player.getPos().y);
+    int x = renderer->drawText(23, 0, "HP: ", Color::Default);
+
+    Color hpColor = Color::Red;
+    double percent = static_cast<double>(player.getHitpoints()) / player.getMaxHitpoints();
+    if (percent >= 0.75) {
+        hpColor = Color::Green;
     }
-    else {
-        printw("HP: %d/%d   Speed: %d   Position: (%d, %d)", player.getHitpoints(), player.getMaxHitpoints(), 
-                                                             player.getSpeed(), player.getPos().x, player.getPos().y);
+    else if (percent >= 0.25) {
+        hpColor = Color::Yellow;
     }
+    snprintf(buffer, sizeof(buffer), "%d/%d", player.getHitpoints(), player.getMaxHitpoints());
+    x = renderer->drawText(23, x, buffer, shade(hpColor));
+
+    snprintf(buffer, sizeof(buffer), "   Speed: %d   Position: (%d, %d)", player.getSpeed(), player.getPos().x, player.getPos().y);
+    renderer->drawText(23, x, buffer, Color::Default);
+}
+
+static void drawObjectCell(int i, int j) {
+    Object *obj = objectsAt[i][j].back();
+    renderer->drawMapChar(i, j, objectsAt[i][j].size() > 1 ? '&' : obj->getSymbol(), shade(obj->getColor()));
 }
 
 void printDungeon() {
+    scrollViewport(player.getPos());
+    drawDungeon();
+}
+
+// The dungeon's edge is drawn as a frame, which on a default sized map is the border of the screen
+static char frameChar(int i, int j) {
+    bool top = i == 0 || i == dungeonHeight - 1;
+    bool side = j == 0 || j == dungeonWidth - 1;
+    if (top && side) {
+        return '+';
+    }
+    return top ? '-' : side ? '|' : '\0';
+}
+
+void drawDungeon() {
+    PhaseProbe probe(Phase::PrintDungeon);
+    animatedCells.clear();
+    if (activeOverlay != Overlay::None) {
+        drawOverlay();
+        if (statsOverlayToggle) {
+            drawStatsOverlay();
+        }
+        renderer->clearToEol(MESSAGE_LINE, 0);
+        renderer->drawText(MESSAGE_LINE, 0, overlayName(activeOverlay), Color::Default);
+        renderer->drawText(MESSAGE_LINE, strlen(overlayName(activeOverlay)), ", press the same key again to close.", Color::Default);
+        printStatus();
+        renderer->present();
+        return;
+    }
+
+    int radius = visionRadius();
     if (fogOfWarToggle) {
-        for (int i = 0; i < MAX_HEIGHT; i++) {
-            for (int j = 0; j < MAX_WIDTH; j++) {
-                if (inLineOfSight((Pos){j, i})) {
+        for (int i = viewOrigin.y; i < viewOrigin.y + VIEW_HEIGHT; i++) {
+            for (int j = viewOrigin.x; j < viewOrigin.x + VIEW_WIDTH; j++) {
+                if (inLineOfSight((Pos){j, i}, radius)) {
                     if (monsterAt[i][j]) {
-                        Color c =  monsterAt[i][j].get()->getColor();
-                        if (supportsColor) {
-                            attron(COLOR_PAIR(c));
-                            mvaddch(i + 1, j,  monsterAt[i][j].get()->getSymbol());
-                            attroff(COLOR_PAIR(c));
-                        }
-                        else {
-                            mvaddch(i + 1, j,  monsterAt[i][j].get()->getSymbol());
+                        Monster *mon = monsterAt[i][j];
+                        if (mon->isMultiColored()) {
+                            animatedCells.push_back((Pos){j, i});
                         }
+                        renderer->drawMapChar(i, j, mon->getSymbol(), shade(mon->getColor()));
                     }
                     else if (!objectsAt[i][j].empty()) {
-                        Color c = objectsAt[i][j].back().get()->getColor();
-                        if (objectsAt[i][j].size() > 1) {
-                            if (supportsColor) {
-                                attron(COLOR_PAIR(c));
-                                mvaddch(i + 1, j, '&');
-                                attroff(COLOR_PAIR(c));
-                            }
-                            else {
-                                mvaddch(i + 1, j, '&');
-                            }
-                        }
-                        else {
-                            if (supportsColor) {
-                                attron(COLOR_PAIR(c));
-                                mvaddch(i + 1, j, objectsAt[i][j].back().get()->getSymbol());
-                                attroff(COLOR_PAIR(c));
-                            }
-                            else {
-                                mvaddch(i + 1, j, objectsAt[i][j].back().get()->getSymbol());
-                            }
+                        if (objectsAt[i][j].back()->isMultiColored() && !(player.getPos() == (Pos){j, i})) {
+                            animatedCells.push_back((Pos){j, i});
                         }
+                        drawObjectCell(i, j);
                     }
                     else {
-                        if (supportsColor) {
-                            attron(COLOR_PAIR(Color::Yellow));
-                            mvaddch(i + 1, j, dungeon[i][j].visible);
-                            attroff(COLOR_PAIR(Color::Yellow));
-                        }
-                        else {
-                            mvaddch(i + 1, j, dungeon[i][j].visible);
-                        }
+                        renderer->drawMapChar(i, j, dungeon[i][j].visible, shade(Color::Yellow));
                     }
                 }
+                else if (dungeon[i][j].visible == FOG) {
+                    renderer->drawMapChar(i, j, dungeon[i][j].visible, shade(Color::Magenta));
+                }
                 else {
-                    if (supportsColor && dungeon[i][j].visible == FOG) {
-                        attron(COLOR_PAIR(Color::Magenta));
-                        mvaddch(i + 1, j, dungeon[i][j].visible);
-                        attroff(COLOR_PAIR(Color::Magenta));
-                    }
-                    else {
-                        mvaddch(i + 1, j, dungeon[i][j].visible);
-                    }
+                    renderer->drawMapChar(i, j, dungeon[i][j].visible, Color::Default);
                 }
             }
         }
 
-        Monster *mon = monsterAt[player.getPos().y][player.getPos().x].get();
+        Monster *mon = monsterAt[player.getPos().y][player.getPos().x];
         if (mon) {
-            Color c = mon->getColor();
-            if (supportsColor) {
-                attron(COLOR_PAIR(c));
-                mvaddch(player.getPos().y + 1, player.getPos().x, mon->getSymbol());
-                attroff(COLOR_PAIR(c));
-            }
-            else {
-                mvaddch(player.getPos().y + 1, player.getPos().x, mon->getSymbol());
+            if (mon->isMultiColored()) {
+                animatedCells.push_back(player.getPos());
             }
+            renderer->drawMapChar(player.getPos().y, player.getPos().x, mon->getSymbol(), shade(mon->getColor()));
         }
         else {
-            mvaddch(player.getPos().y + 1, player.getPos().x, '@');
+            renderer->drawMapChar(player.getPos().y, player.getPos().x, '@', Color::Default);
         }
         
     }
     else {
-        if (supportsColor) {
-            attron(COLOR_PAIR(Color::Magenta));
-
-            mvhline(1, 0, '-', MAX_WIDTH - 1);
-            mvhline(MAX_HEIGHT, 0, '-', MAX_WIDTH - 1);
-            mvvline(1, 0, '|', MAX_HEIGHT - 1);
-            mvvline(1, MAX_WIDTH - 1, '|', MAX_HEIGHT - 1);
-
-            mvaddch(1, 0, '+');
-            mvaddch(1, MAX_WIDTH - 1, '+');
-            mvaddch(MAX_HEIGHT, 0, '+');
-            mvaddch(MAX_HEIGHT, MAX_WIDTH - 1, '+');
-
-            attroff(COLOR_PAIR(Color::Magenta));
-        }
-        else {
-            mvhline(1, 0, '-', MAX_WIDTH - 1);
-            mvhline(MAX_HEIGHT, 0, '-', MAX_WIDTH - 1);
-            mvvline(1, 0, '|', MAX_HEIGHT - 1);
-            mvvline(1, MAX_WIDTH - 1, '|', MAX_HEIGHT - 1);
-
-            mvaddch(1, 0, '+');
-            mvaddch(1, MAX_WIDTH - 1, '+');
-            mvaddch(MAX_HEIGHT, 0, '+');
-            mvaddch(MAX_HEIGHT, MAX_WIDTH - 1, '+');
-        }
-
-        for (int i = 1; i < MAX_HEIGHT - 1; i++) {
-            for (int j = 1; j < MAX_WIDTH - 1; j++) {
-                if (player.getPos().x == j && player.getPos().y == i) {
-                    mvaddch(i + 1, j, '@');
+        Color border = shade(Color::Magenta);
+        for (int i = viewOrigin.y; i < viewOrigin.y + VIEW_HEIGHT; i++) {
+            for (int j = viewOrigin.x; j < viewOrigin.x + VIEW_WIDTH; j++) {
+                if (frameChar(i, j)) {
+                    renderer->drawMapChar(i, j, frameChar(i, j), border);
+                }
+                else if (player.getPos().x == j && player.getPos().y == i) {
+                    renderer->drawMapChar(i, j, '@', Color::Default);
                 }
                 else if (monsterAt[i][j]) {
-                    if (supportsColor) {
-                        Color c = monsterAt[i][j].get()->getColor();
-                        attron(COLOR_PAIR(c));
-                        mvaddch(i + 1, j, monsterAt[i][j].get()->getSymbol());
-                        attroff(COLOR_PAIR(c));
-                    }
-                    else {
-                        mvaddch(i + 1, j, monsterAt[i][j].get()->getSymbol());
+                    Monster *mon = monsterAt[i][j];
+                    if (mon->isMultiColored()) {
+                        animatedCells.push_back((Pos){j, i});
                     }
+                    renderer->drawMapChar(i, j, mon->getSymbol(), shade(mon->getColor()));
                 }
                 else if (!objectsAt[i][j].empty()) {
-                    Color c = objectsAt[i][j].back().get()->getColor();
-                    if (objectsAt[i][j].size() > 1) {
-                        if (supportsColor) {
-                            attron(COLOR_PAIR(c));
-                            mvaddch(i + 1, j, '&');
-                            attroff(COLOR_PAIR(c));
-                        }
-                        else {
-                            mvaddch(i + 1, j, '&');
-                        }
-                    }
-                    else {
-                        if (supportsColor) {
-                            attron(COLOR_PAIR(c));
-                            mvaddch(i + 1, j, objectsAt[i][j].back().get()->getSymbol());
-                            attroff(COLOR_PAIR(c));
-                        }
-                        else {
-                            mvaddch(i + 1, j, objectsAt[i][j].back().get()->getSymbol());
-                        }
+                    if (objectsAt[i][j].back()->isMultiColored()) {
+                        animatedCells.push_back((Pos){j, i});
                     }
+                    drawObjectCell(i, j);
+                }
+                else if (inLineOfSight((Pos){j, i}, radius)) {
+                    renderer->drawMapChar(i, j, dungeon[i][j].type, shade(Color::Yellow));
                 }
                 else {
-                    if (supportsColor) {
-                        if (inLineOfSight((Pos){j, i})) {
-                            attron(COLOR_PAIR(Color::Yellow));
-                            mvaddch(i + 1, j, dungeon[i][j].type);
-                            attroff(COLOR_PAIR(Color::Yellow));
-                        }
-                        else {
-                            mvaddch(i + 1, j, dungeon[i][j].type);
-                        }
-                    }
-                    else {
-                        mvaddch(i + 1, j, dungeon[i][j].type);
-                    }
+                    renderer->drawMapChar(i, j, dungeon[i][j].type, Color::Default);
                 }
             }
         }
     }
     
-    printLine(MESSAGE_LINE, "Press a key to continue... or press '?' for help.");
+    if (statsOverlayToggle) {
+        drawStatsOverlay();
+    }
+
+    // One present for the whole frame, the message and status lines ride along with the map
+    renderer->clearToEol(MESSAGE_LINE, 0);
+    renderer->drawText(MESSAGE_LINE, 0, "Press a key to continue... or press '?' for help.", Color::Default);
     printStatus();
+    renderer->present();
 }
 
-void monsterList() {
-    std::vector<std::string> allLines;
-    std::vector<Color> colorList;
-    int count = 0;
-    for (int i = 0; i < MAX_HEIGHT; i++) {
-        for (int j = 0; j < MAX_WIDTH; j++) {
-            if (monsterAt[i][j]) {
-                Monster *mon = monsterAt[i][j].get();
-                MonsterType *monType = &monsterTypeList[mon->getMonTypeIndex()];
-
-                std::string nameLine = mon->getName() + " (" + std::string(1, mon->getSymbol()) + ")";
-
-                std::vector<std::string> abilityLines;
-                int abilityCount = monType->abils.size();
-                if (abilityCount <= 0) {
-                    abilityLines.push_back("    - Abilities: None");
-                } else {
-                    std::string abilityLine = "    - Abilities: ";
-                    int abilIndex = 0;
-                    while (abilIndex < abilityCount) {
-                        abilityLine += monType->abils[abilIndex];
-                        abilIndex++;
-
-                        if (abilIndex < abilityCount) {
-                            abilityLine += ", ";
-                        }
+static std::string locationLine(Pos pos, bool allowHere) {
+    std::string locationLine = "    - Location: ";
+    int x = pos.x - player.getPos().x;
+    int y = pos.y - player.getPos().y;
+    const char* nsDir = (y >= 0) ? "South" : "North";
+    const char* ewDir = (x >= 0) ? "East" : "West";
+    int nsDist = abs(y);
+    int ewDist = abs(x);
+    if (allowHere && nsDist == 0 && ewDist == 0) {
+        locationLine += "Here";
+    }
+    else if (nsDist == 0) {
+        locationLine += std::to_string(ewDist) + " " + ewDir;
+    }
+    else if (ewDist == 0) {
+        locationLine += std::to_string(nsDist) + " " + nsDir;
+    }
+    else {
+        locationLine += std::to_string(nsDist) + " " + nsDir + " and " + std::to_string(ewDist) + " " + ewDir;
+    }
+    return locationLine;
+}
 
-                        if (abilIndex % 4 == 0 || abilIndex == abilityCount) {
-                            abilityLines.push_back(abilityLine);
-                            abilityLine = "                 ";
-                        }
-                    }
-                }
-                
-
-                std::string locationLine = "    - Location: ";
-                int x = mon->getPos().x - player.getPos().x;
-                int y = mon->getPos().y - player.getPos().y;
-                const char* nsDir = (y >= 0) ? "South" : "North";
-                const char* ewDir = (x >= 0) ? "East" : "West";
-                int nsDist = abs(y);
-                int ewDist = abs(x);
-                if (nsDist == 0) {
-                    locationLine += std::to_string(ewDist) + " " + ewDir;
-                }
-                else if (ewDist == 0) {
-                    locationLine += std::to_string(nsDist) + " " + nsDir;
-                }
-                else {
-                    locationLine += std::to_string(nsDist) + " " + nsDir + " and " + std::to_string(ewDist) + " " + ewDir;
-                }
+// Must produce exactly monsterRowCount(mon) lines
+static void appendMonsterLines(Monster *mon, std::vector<std::string>& allLines, std::vector<Color>& colorList) {
+    MonsterType *monType = &monsterTypeList[mon->getMonTypeIndex()];
 
-                allLines.push_back(nameLine);
-                colorList.push_back(mon->getColor());
+    allLines.push_back(mon->getName() + " (" + std::string(1, mon->getSymbol()) + ")");
+    colorList.push_back(mon->getColor());
 
-                for (const auto& line : abilityLines) {
-                    allLines.push_back(line);
-                    colorList.push_back(Color::White);
-                }
+    int abilityCount = monType->abils.size();
+    if (abilityCount <= 0) {
+        allLines.push_back("    - Abilities: None");
+        colorList.push_back(Color::White);
+    } else {
+        std::string abilityLine = "    - Abilities: ";
+        int abilIndex = 0;
+        while (abilIndex < abilityCount) {
+            abilityLine += monType->abils[abilIndex];
+            abilIndex++;
 
-                allLines.push_back(locationLine);
-                colorList.push_back(Color::White);
+            if (abilIndex < abilityCount) {
+                abilityLine += ", ";
+            }
 
-                count++;
+            if (abilIndex % 4 == 0 || abilIndex == abilityCount) {
+                allLines.push_back(abilityLine);
+                colorList.push_back(Color::White);
+                abilityLine = "                 ";
             }
         }
     }
 
+    allLines.push_back(locationLine(mon->getPos(), false));
+    colorList.push_back(Color::White);
+}
+
+void monsterList() {
+    sortRosters(player.getPos());
+
+    // Row offsets are plain integers, text is only built for the rows scrolled into view
+    std::vector<size_t> firstRow;
+    size_t totalRows = 0;
+    for (Monster *mon : monsterRoster) {
+        firstRow.push_back(totalRows);
+        totalRows += monsterRowCount(mon);
+    }
+    int count = monsterRoster.size();
+
     int cols = 55;
     int rows = 24;
-    int leftCol = (MAX_WIDTH - cols) / 2;
+    int leftCol = (VIEW_WIDTH - cols) / 2;
     if (leftCol < 0) leftCol = 0;
     size_t topLine = 0;
     size_t maxDisplay = rows - 7;
 
-    clear();
+    WINDOW *win = openPanel(0, 0, 0, 0);
     if (supportsColor) {
-        attron(COLOR_PAIR(Color::Green));
+        wattron(win, COLOR_PAIR(Color::Green));
 
-        mvhline(0, leftCol, '-', cols);
-        mvhline(rows - 1, leftCol, '-', cols);
-        mvvline(0, leftCol, '|', rows);
-        mvvline(0, leftCol + cols - 1, '|', rows);
+        mvwhline(win, 0, leftCol, '-', cols);
+        mvwhline(win, rows - 1, leftCol, '-', cols);
+        mvwvline(win, 0, leftCol, '|', rows);
+        mvwvline(win, 0, leftCol + cols - 1, '|', rows);
 
-        mvaddch(0, leftCol + cols / 2, '+');
-        mvaddch(0, leftCol, '+');
-        mvaddch(rows - 1, leftCol + cols / 2, '+');
-        mvaddch(rows - 1, leftCol, '+');
-        mvaddch(0, leftCol + cols - 1, '+');
-        mvaddch(rows - 1, leftCol + cols - 1, '+');
+        mvwaddch(win, 0, leftCol + cols / 2, '+');
+        mvwaddch(win, 0, leftCol, '+');
+        mvwaddch(win, rows - 1, leftCol + cols / 2, '+');
+        mvwaddch(win, rows - 1, leftCol, '+');
+        mvwaddch(win, 0, leftCol + cols - 1, '+');
+        mvwaddch(win, rows - 1, leftCol + cols - 1, '+');
 
-        attroff(COLOR_PAIR(Color::Green));
+        wattroff(win, COLOR_PAIR(Color::Green));
     }
     else {
-        mvhline(0, leftCol, '-', cols);
-        mvhline(rows - 1, leftCol, '-', cols);
-        mvvline(0, leftCol, '|', rows);
-        mvvline(0, leftCol + cols - 1, '|', rows);
-
-        mvaddch(0, leftCol + cols / 2, '+');
-        mvaddch(0, leftCol, '+');
-        mvaddch(rows - 1, leftCol + cols / 2, '+');
-        mvaddch(rows - 1, leftCol, '+');
-        mvaddch(0, leftCol + cols - 1, '+');
-        mvaddch(rows - 1, leftCol + cols - 1, '+');
+        mvwhline(win, 0, leftCol, '-', cols);
+        mvwhline(win, rows - 1, leftCol, '-', cols);
+        mvwvline(win, 0, leftCol, '|', rows);
+        mvwvline(win, 0, leftCol + cols - 1, '|', rows);
+
+        mvwaddch(win, 0, leftCol + cols / 2, '+');
+        mvwaddch(win, 0, leftCol, '+');
+        mvwaddch(win, rows - 1, leftCol + cols / 2, '+');
+        mvwaddch(win, rows - 1, leftCol, '+');
+        mvwaddch(win, 0, leftCol + cols - 1, '+');
+        mvwaddch(win, rows - 1, leftCol + cols - 1, '+');
     }
 
     const char title[13] = "Monster List";
     int titleCol = leftCol + (cols - strlen(title)) / 2;
-    mvprintw(1, titleCol, "%s", title);
-    mvprintw(3, leftCol + 2, "Monsters alive: %d", count);
+    mvwprintw(win, 1, titleCol, "%s", title);
+    mvwprintw(win, 3, leftCol + 2, "Monsters alive: %d", count);
 
     while (true) {
-        move(4, leftCol + cols / 2);
+        wmove(win, 4, leftCol + cols / 2);
         if (topLine > 0) {
-            printw("^");
+            wprintw(win, "^");
         }
         else {
-            printw(" ");
+            wprintw(win, " ");
+        }
+
+        std::vector<std::string> allLines;
+        std::vector<Color> colorList;
+        size_t windowStart = 0;
+        if (count > 0) {
+            size_t entity = std::upper_bound(firstRow.begin(), firstRow.end(), topLine) - firstRow.begin() - 1;
+            windowStart = firstRow[entity];
+            for (size_t e = entity; e < monsterRoster.size() && windowStart + allLines.size() < topLine + maxDisplay; e++) {
+                appendMonsterLines(monsterRoster[e], allLines, colorList);
+            }
         }
 
         int displayStartRow = 5;
         for (size_t i = 0; i < maxDisplay; i++) {
             int row = displayStartRow + i;
-            size_t lineIndex = topLine + i;
+            size_t lineIndex = topLine - windowStart + i;
 
-            move(row, leftCol + 2);
-            clrtoeol();
+            wmove(win, row, leftCol + 2);
+            wclrtoeol(win);
             if (lineIndex < allLines.size()) {
                 std::string line = allLines[lineIndex];
                 if (supportsColor) {
-                    printw("%s", line.substr(0, line.size() - 2).c_str());
-                    attron(COLOR_PAIR(colorList[lineIndex]));
-                    addch(line[line.size() - 2]);
-                    attroff(COLOR_PAIR(colorList[lineIndex]));
-                    addch(line[line.size() - 1]);
+                    wprintw(win, "%s", line.substr(0, line.size() - 2).c_str());
+                    wattron(win, COLOR_PAIR(colorList[lineIndex]));
+                    waddch(win, line[line.size() - 2]);
+                    wattroff(win, COLOR_PAIR(colorList[lineIndex]));
+                    waddch(win, line[line.size() - 1]);
                 }
                 else {
-                    printw("%s", line.c_str());
+                    wprintw(win, "%s", line.c_str());
                 }
             } 
-            move(row, leftCol + cols - 1);
-            clrtoeol();
+            wmove(win, row, leftCol + cols - 1);
+            wclrtoeol(win);
             if (supportsColor) {
-                attron(COLOR_PAIR(Color::Green));
-                addch('|');
-                attroff(COLOR_PAIR(Color::Green));
+                wattron(win, COLOR_PAIR(Color::Green));
+                waddch(win, '|');
+                wattroff(win, COLOR_PAIR(Color::Green));
             }
             else {
-                addch('|');
+                waddch(win, '|');
             }
         }
 
-        move(rows - 2, leftCol + cols / 2);
-        if (topLine + maxDisplay < allLines.size()) {
-            printw("v");
+        wmove(win, rows - 2, leftCol + cols / 2);
+        if (topLine + maxDisplay < totalRows) {
+            wprintw(win, "v");
         }
         else {
-            printw(" ");    
+            wprintw(win, " ");    
         }
 
-        refresh();
+        wrefresh(win);
 
         int ch;
         do {
-            ch = getch();
+            ch = wgetch(win);
         } while (ch != KEY_UP && ch != KEY_DOWN && ch != 'm' && ch != 27);
 
         switch (ch) {
@@ -1100,158 +1007,135 @@ void monsterList() {
                 break;
 
             case KEY_DOWN:
-                if (topLine + maxDisplay < allLines.size()) {
+                if (topLine + maxDisplay < totalRows) {
                     topLine++;
                 }
                 break;
 
             case 'm':
             case 27:
-                clear();
-                printDungeon();
+                closePanel(win);
                 return;
         }
     }
 }
 
 void objectList() {
-    std::vector<std::string> allLines;
-    std::vector<Color> colorList;
-    int count = 0;
-    for (int i = 0; i < MAX_HEIGHT; i++) {
-        for (int j = 0; j < MAX_WIDTH; j++) {
-            for (const auto& obj : objectsAt[i][j]) {
-                std::string nameLine = obj->getName() + " (" + std::string(1, obj->getSymbol()) + ")";
-
-                std::string locationLine = "    - Location: ";
-                int x = obj->getPos().x - player.getPos().x;
-                int y = obj->getPos().y - player.getPos().y;
-                const char* nsDir = (y >= 0) ? "South" : "North";
-                const char* ewDir = (x >= 0) ? "East" : "West";
-                int nsDist = abs(y);
-                int ewDist = abs(x);
-                if (nsDist == 0 && ewDist == 0) {
-                    locationLine += "Here";
-                }
-                else if (nsDist == 0) {
-                    locationLine += std::to_string(ewDist) + " " + ewDir;
-                }
-                else if (ewDist == 0) {
-                    locationLine += std::to_string(nsDist) + " " + nsDir;
-                }
-                else {
-                    locationLine += std::to_string(nsDist) + " " + nsDir + " and " + std::to_string(ewDist) + " " + ewDir;
-                }
-
-                allLines.push_back(nameLine);
-                colorList.push_back(obj->getColor());
+    sortRosters(player.getPos());
 
-                allLines.push_back(locationLine);
-                colorList.push_back(Color::White);
-
-                count++;
-            }
-        }
-    }
+    // Two rows per object, so the visible window maps straight onto the roster
+    size_t totalRows = objectRoster.size() * 2;
+    int count = objectRoster.size();
 
     int cols = 55;
     int rows = 24;
     int displayStartRow = 5;
-    int leftCol = (MAX_WIDTH - cols) / 2;
+    int leftCol = (VIEW_WIDTH - cols) / 2;
     if (leftCol < 0) leftCol = 0;
     size_t topLine = 0;
     size_t maxDisplay = rows - 7;
 
-    clear();
+    WINDOW *win = openPanel(0, 0, 0, 0);
     if (supportsColor) {
-        attron(COLOR_PAIR(Color::Cyan));
+        wattron(win, COLOR_PAIR(Color::Cyan));
 
-        mvhline(0, leftCol, '-', cols);
-        mvhline(rows - 1, leftCol, '-', cols);
-        mvvline(0, leftCol, '|', rows);
-        mvvline(0, leftCol + cols - 1, '|', rows);
+        mvwhline(win, 0, leftCol, '-', cols);
+        mvwhline(win, rows - 1, leftCol, '-', cols);
+        mvwvline(win, 0, leftCol, '|', rows);
+        mvwvline(win, 0, leftCol + cols - 1, '|', rows);
 
-        mvaddch(0, leftCol + cols / 2, '+');
-        mvaddch(0, leftCol, '+');
-        mvaddch(rows - 1, leftCol + cols / 2, '+');
-        mvaddch(rows - 1, leftCol, '+');
-        mvaddch(0, leftCol + cols - 1, '+');
-        mvaddch(rows - 1, leftCol + cols - 1, '+');
+        mvwaddch(win, 0, leftCol + cols / 2, '+');
+        mvwaddch(win, 0, leftCol, '+');
+        mvwaddch(win, rows - 1, leftCol + cols / 2, '+');
+        mvwaddch(win, rows - 1, leftCol, '+');
+        mvwaddch(win, 0, leftCol + cols - 1, '+');
+        mvwaddch(win, rows - 1, leftCol + cols - 1, '+');
 
-        attroff(COLOR_PAIR(Color::Cyan));
+        wattroff(win, COLOR_PAIR(Color::Cyan));
     }
     else {
-        mvhline(0, leftCol, '-', cols);
-        mvhline(rows - 1, leftCol, '-', cols);
-        mvvline(0, leftCol, '|', rows);
-        mvvline(0, leftCol + cols - 1, '|', rows);
-
-        mvaddch(0, leftCol + cols / 2, '+');
-        mvaddch(0, leftCol, '+');
-        mvaddch(rows - 1, leftCol + cols / 2, '+');
-        mvaddch(rows - 1, leftCol, '+');
-        mvaddch(0, leftCol + cols - 1, '+');
-        mvaddch(rows - 1, leftCol + cols - 1, '+');
+        mvwhline(win, 0, leftCol, '-', cols);
+        mvwhline(win, rows - 1, leftCol, '-', cols);
+        mvwvline(win, 0, leftCol, '|', rows);
+        mvwvline(win, 0, leftCol + cols - 1, '|', rows);
+
+        mvwaddch(win, 0, leftCol + cols / 2, '+');
+        mvwaddch(win, 0, leftCol, '+');
+        mvwaddch(win, rows - 1, leftCol + cols / 2, '+');
+        mvwaddch(win, rows - 1, leftCol, '+');
+        mvwaddch(win, 0, leftCol + cols - 1, '+');
+        mvwaddch(win, rows - 1, leftCol + cols - 1, '+');
     }
 
     const char title[13] = "Object List";
     int titleCol = leftCol + (cols - strlen(title)) / 2;
-    mvprintw(1, titleCol, "%s", title);
-    mvprintw(3, leftCol + 2, "Objects in Dungeon: %d", count);
+    mvwprintw(win, 1, titleCol, "%s", title);
+    mvwprintw(win, 3, leftCol + 2, "Objects in Dungeon: %d", count);
     
     while (true) {
-        move(4, leftCol + cols / 2);
+        wmove(win, 4, leftCol + cols / 2);
         if (topLine > 0) {
-            printw("^");
+            wprintw(win, "^");
         }
         else {
-            printw(" ");
+            wprintw(win, " ");
+        }
+
+        std::vector<std::string> allLines;
+        std::vector<Color> colorList;
+        size_t windowStart = topLine - topLine % 2;
+        for (size_t e = windowStart / 2; e < objectRoster.size() && windowStart + allLines.size() < topLine + maxDisplay; e++) {
+            Object *obj = objectRoster[e];
+            allLines.push_back(obj->getName() + " (" + std::string(1, obj->getSymbol()) + ")");
+            colorList.push_back(obj->getColor());
+            allLines.push_back(locationLine(obj->getPos(), true));
+            colorList.push_back(Color::White);
         }
 
         for (size_t i = 0; i < maxDisplay; i++) {
             int row = displayStartRow + i;
-            size_t lineIndex = topLine + i;
+            size_t lineIndex = topLine - windowStart + i;
 
-            move(row, leftCol + 2);
-            clrtoeol();
+            wmove(win, row, leftCol + 2);
+            wclrtoeol(win);
             if (lineIndex < allLines.size()) {
                 std::string line = allLines[lineIndex];
                 if (supportsColor) {
-                    printw("%s", line.substr(0, line.size() - 2).c_str());
-                    attron(COLOR_PAIR(colorList[lineIndex]));
-                    addch(line[line.size() - 2]);
-                    attroff(COLOR_PAIR(colorList[lineIndex]));
-                    addch(line[line.size() - 1]);
+                    wprintw(win, "%s", line.substr(0, line.size() - 2).c_str());
+                    wattron(win, COLOR_PAIR(colorList[lineIndex]));
+                    waddch(win, line[line.size() - 2]);
+                    wattroff(win, COLOR_PAIR(colorList[lineIndex]));
+                    waddch(win, line[line.size() - 1]);
                 }
                 else {
-                    printw("%s", line.c_str());
+                    wprintw(win, "%s", line.c_str());
                 }
             } 
-            move(row, leftCol + cols - 1);
-            clrtoeol();
+            wmove(win, row, leftCol + cols - 1);
+            wclrtoeol(win);
             if (supportsColor) {
-                attron(COLOR_PAIR(Color::Cyan));
-                addch('|');
-                attroff(COLOR_PAIR(Color::Cyan));
+                wattron(win, COLOR_PAIR(Color::Cyan));
+                waddch(win, '|');
+                wattroff(win, COLOR_PAIR(Color::Cyan));
             }
             else {
-                addch('|');
+                waddch(win, '|');
             }
         }
 
-        move(rows - 2, leftCol + cols / 2);
-        if (topLine + maxDisplay < allLines.size()) {
-            printw("v");
+        wmove(win, rows - 2, leftCol + cols / 2);
+        if (topLine + maxDisplay < totalRows) {
+            wprintw(win, "v");
         }
         else {
-            printw(" ");    
+            wprintw(win, " ");    
         }
 
-        refresh();
+        wrefresh(win);
 
         int ch;
         do {
-            ch = getch();
+            ch = wgetch(win);
         } while (ch != KEY_UP && ch != KEY_DOWN && ch != 'o' && ch != 27);
 
         switch (ch) {
@@ -1262,15 +1146,14 @@ void objectList() {
                 break;
 
             case KEY_DOWN:
-                if (topLine + maxDisplay < allLines.size()) {
+                if (topLine + maxDisplay < totalRows) {
                     topLine++;
                 }
                 break;
 
             case 'o':
             case 27:
-                clear();
-                printDungeon();
+                closePanel(win);
                 return;
         }
     }
@@ -1287,12 +1170,12 @@ void viewActions(std::vector<std::pair<std::string, Color>>& actions) {
     int width = maxStringLength + 1;
     int height = actions.size() > 17 ? 19 : actions.size();
     int startX = 0;
-    int startY = MAX_HEIGHT - height + 2;
+    int startY = VIEW_HEIGHT - height + 2;
 
     size_t topLine = 0;
     size_t maxDisplay = 17;
 
-    WINDOW *actionWin = newwin(height, width, startY, startX);
+    WINDOW *actionWin = openPanel(height, width, startY, startX);
 
     while (true) {
         if (actions.size() > maxDisplay) {
@@ -1342,7 +1225,8 @@ void viewActions(std::vector<std::pair<std::string, Color>>& actions) {
             tv.tv_sec = 0;
             tv.tv_usec = 180000;
             redisplayColorsOutsideWindow(height, width, startY, startX);
-            refresh();
+            renderer->present();
+            refreshPanels();
         } while (!select(STDIN_FILENO + 1, &readfs, nullptr, nullptr, &tv));
 
         int ch = getch();
@@ -1362,74 +1246,13 @@ void viewActions(std::vector<std::pair<std::string, Color>>& actions) {
 
             case 'v':
             case 27:
-                delwin(actionWin);
-                printDungeon();
-                printLine(STATUS_LINE1, "%s   v - View actions", actions.back().first.c_str());
+                closePanel(actionWin);
+                printLine(MESSAGE_LINE, "Press a key to continue... or press '?' for help.");
                 return;
         }
     }
 }
 
-void nonTunnelingDistMap() {
-    clear();
-    printLine(MESSAGE_LINE, "Press 'ESC' or 'D' to return");
-    printLine(STATUS_LINE2, "Non-tunneling distance map.");
-
-    generateDistances(player.getPos());
-    for (int i = 0; i < MAX_HEIGHT; i++) {
-        for (int j = 0; j < MAX_WIDTH; j++) {
-            move(i + 1, j);
-            if (dungeon[i][j].nonTunnelingDist == UNREACHABLE) {
-                addch(' ');
-            }
-            else if (dungeon[i][j].nonTunnelingDist == 0) {
-                addch('@');
-            }
-            else {
-                if (supportsColor) {
-                    if (dungeon[i][j].nonTunnelingDist < 10) {
-                        attron(COLOR_PAIR(Color::Red));
-                        addch(dungeon[i][j].nonTunnelingDist % 10 + '0');
-                        attroff(COLOR_PAIR(Color::Red));
-                    }
-                    else if (dungeon[i][j].nonTunnelingDist < 20) {
-                        attron(COLOR_PAIR(Color::Yellow));
-                        addch(dungeon[i][j].nonTunnelingDist % 10 + '0');
-                        attroff(COLOR_PAIR(Color::Yellow));
-                    }
-                    else if (dungeon[i][j].nonTunnelingDist < 30) {
-                        attron(COLOR_PAIR(Color::Green));
-                        addch(dungeon[i][j].nonTunnelingDist % 10 + '0');
-                        attroff(COLOR_PAIR(Color::Green));
-                    }
-                    else if (dungeon[i][j].nonTunnelingDist < 40) {
-                        attron(COLOR_PAIR(Color::Cyan));
-                        addch(dungeon[i][j].nonTunnelingDist % 10 + '0');
-                        attroff(COLOR_PAIR(Color::Cyan));
-                    }
-                    else {
-                        attron(COLOR_PAIR(Color::Blue));
-                        addch(dungeon[i][j].nonTunnelingDist % 10 + '0');
-                        attroff(COLOR_PAIR(Color::Blue));
-                    }
-                }
-                else {
-                    addch(dungeon[i][j].nonTunnelingDist % 10 + '0');
-                } 
-            }
-        }
-    }
-
-    refresh();
-
-    int ch;
-    do {
-        ch = getch();
-    } while (ch != 27 && ch != 'D');
-
-    printDungeon();
-}
-
 void showEquipmentObjectDescription() {
     printLine(MESSAGE_LINE, "Choose an equipment slot a-l");
     int ch = getch();
@@ -1439,10 +1262,11 @@ void showEquipmentObjectDescription() {
             printLine(MESSAGE_LINE, "Nothing in that slot.");
             return;
         }
-        std::string itemName = player.getEquipmentItem((Equip)index)->getDescription();
+        const std::string& itemName = player.getEquipmentItem((Equip)index)->getDescription();
         clear();
         mvprintw(0, 0, "%s", itemName.c_str());
         getch();
+        renderer->invalidate();
         printDungeon();
     }
     else if (ch == 'E' || ch == 27) {
@@ -1462,10 +1286,11 @@ void showInventoryObjectDescription() {
             printLine(MESSAGE_LINE, "Nothing in that slot.");
             return;
         }
-        std::string itemName = player.getInventoryItem(index)->getDescription();
+        const std::string& itemName = player.getInventoryItem(index)->getDescription();
         clear();
         mvprintw(0, 0, "%s", itemName.c_str());
         getch();
+        renderer->invalidate();
         printDungeon();
     }
     else if (ch == 'I' || ch == 27) {
@@ -1477,7 +1302,7 @@ void showInventoryObjectDescription() {
 }
 
 void showMonsterInfo(Pos pos) {
-    Monster *mon = monsterAt[pos.y][pos.x].get();
+    Monster *mon = monsterAt[pos.y][pos.x];
     if (mon == nullptr) {
         return;
     }
@@ -1486,66 +1311,7 @@ void showMonsterInfo(Pos pos) {
     mvprintw(2, 0, "%s", mon->getDescription().c_str());
     
     getch();
-    printDungeon();    
-}
-
-void tunnelingDistMap() {
-    clear();
-    printLine(MESSAGE_LINE, "Press 'ESC' or 'T' to return");
-    printLine(STATUS_LINE2, "Tunneling distance map.");
-
-    generateDistances(player.getPos());   
-    for (int i = 0; i < MAX_HEIGHT; i++) {
-        for (int j = 0; j < MAX_WIDTH; j++) {
-            move(i + 1, j);
-            if (dungeon[i][j].tunnelingDist == UNREACHABLE) {
-                addch(' ');
-            }
-            else if (dungeon[i][j].tunnelingDist == 0) {
-                addch('@');
-            }
-            else {
-                if (supportsColor) {
-                    if (dungeon[i][j].tunnelingDist < 10) {
-                        attron(COLOR_PAIR(Color::Red));
-                        addch(dungeon[i][j].tunnelingDist % 10 + '0');
-                        attroff(COLOR_PAIR(Color::Red));
-                    }
-                    else if (dungeon[i][j].tunnelingDist < 20) {
-                        attron(COLOR_PAIR(Color::Yellow));
-                        addch(dungeon[i][j].tunnelingDist % 10 + '0');
-                        attroff(COLOR_PAIR(Color::Yellow));
-                    }
-                    else if (dungeon[i][j].tunnelingDist < 30) {
-                        attron(COLOR_PAIR(Color::Green));
-                        addch(dungeon[i][j].tunnelingDist % 10 + '0');
-                        attroff(COLOR_PAIR(Color::Green));
-                    }
-                    else if (dungeon[i][j].tunnelingDist < 40) {
-                        attron(COLOR_PAIR(Color::Cyan));
-                        addch(dungeon[i][j].tunnelingDist % 10 + '0');
-                        attroff(COLOR_PAIR(Color::Cyan));
-                    }
-                    else {
-                        attron(COLOR_PAIR(Color::Blue));
-                        addch(dungeon[i][j].tunnelingDist % 10 + '0');
-                        attroff(COLOR_PAIR(Color::Blue));
-                    }
-                }
-                else {
-                    addch(dungeon[i][j].tunnelingDist % 10 + '0');
-                } 
-            }
-        }
-    }
-
-    refresh();
-
-    int ch;
-    do {
-        ch = getch();
-    } while (ch != 27 && ch != 'T');
-
+    renderer->invalidate();
     printDungeon();
 }
 
@@ -1554,85 +1320,85 @@ void commandList() {
 
     int cols = 55;
     int rows = 24;
-    int leftCol = (MAX_WIDTH - cols) / 2;
+    int leftCol = (VIEW_WIDTH - cols) / 2;
     if (leftCol < 0) leftCol = 0;
     int top = 0;
 
-    clear();
+    WINDOW *win = openPanel(0, 0, 0, 0);
     while (true) {
         if (supportsColor) {
-            attron(COLOR_PAIR(Color::Yellow));
+            wattron(win, COLOR_PAIR(Color::Yellow));
 
-            mvhline(0, leftCol, '-', cols);
-            mvhline(rows - 1, leftCol, '-', cols);
-            mvvline(0, leftCol, '|', rows);
-            mvvline(0, leftCol + cols - 1, '|', rows);
+            mvwhline(win, 0, leftCol, '-', cols);
+            mvwhline(win, rows - 1, leftCol, '-', cols);
+            mvwvline(win, 0, leftCol, '|', rows);
+            mvwvline(win, 0, leftCol + cols - 1, '|', rows);
 
-            mvaddch(0, leftCol + cols / 2, '+');
-            mvaddch(0, leftCol, '+');
-            mvaddch(rows - 1, leftCol + cols / 2, '+');
-            mvaddch(rows - 1, leftCol, '+');
-            mvaddch(0, leftCol + cols - 1, '+');
-            mvaddch(rows - 1, leftCol + cols - 1, '+');
+            mvwaddch(win, 0, leftCol + cols / 2, '+');
+            mvwaddch(win, 0, leftCol, '+');
+            mvwaddch(win, rows - 1, leftCol + cols / 2, '+');
+            mvwaddch(win, rows - 1, leftCol, '+');
+            mvwaddch(win, 0, leftCol + cols - 1, '+');
+            mvwaddch(win, rows - 1, leftCol + cols - 1, '+');
 
-            attroff(COLOR_PAIR(Color::Yellow));
+            wattroff(win, COLOR_PAIR(Color::Yellow));
         }
         else {
-            mvhline(0, leftCol, '-', cols);
-            mvhline(rows - 1, leftCol, '-', cols);
-            mvvline(0, leftCol, '|', rows);
-            mvvline(0, leftCol + cols - 1, '|', rows);
+            mvwhline(win, 0, leftCol, '-', cols);
+            mvwhline(win, rows - 1, leftCol, '-', cols);
+            mvwvline(win, 0, leftCol, '|', rows);
+            mvwvline(win, 0, leftCol + cols - 1, '|', rows);
 
-            mvaddch(0, leftCol + cols / 2, '+');
-            mvaddch(0, leftCol, '+');
-            mvaddch(rows - 1, leftCol + cols / 2, '+');
-            mvaddch(rows - 1, leftCol, '+');
-            mvaddch(0, leftCol + cols - 1, '+');
-            mvaddch(rows - 1, leftCol + cols - 1, '+');
+            mvwaddch(win, 0, leftCol + cols / 2, '+');
+            mvwaddch(win, 0, leftCol, '+');
+            mvwaddch(win, rows - 1, leftCol + cols / 2, '+');
+            mvwaddch(win, rows - 1, leftCol, '+');
+            mvwaddch(win, 0, leftCol + cols - 1, '+');
+            mvwaddch(win, rows - 1, leftCol + cols - 1, '+');
         }
 
         const char title[13] = "Command List";
         int titleCol = leftCol + (cols - strlen(title)) / 2;
-        mvprintw(1, titleCol, "%s", title);
+        mvwprintw(win, 1, titleCol, "%s", title);
 
-        move(4, leftCol + cols / 2);
+        wmove(win, 4, leftCol + cols / 2);
         if (top > 0) {
-            printw("^");
+            wprintw(win, "^");
         }
         else {
-            printw(" ");
+            wprintw(win, " ");
         }
 
         int maxDisplay = rows - 7;
         for (int i = top; i < top + maxDisplay && i < count; i++) {
             int row = 5 + (i - top);
-            move(row, leftCol + 2);
-            clrtoeol();
-            mvprintw(row, leftCol + 8, "%18s - %s", switches[i].buttons, switches[i].desc);
+            wmove(win, row, leftCol + 2);
+            wclrtoeol(win);
+            mvwprintw(win, row, leftCol + 8, "%18s - %s", switches[i].buttons, switches[i].desc);
 
             if (supportsColor) {
-                attron(COLOR_PAIR(Color::Yellow));
-                mvaddch(row, leftCol + cols - 1, '|');
-                attroff(COLOR_PAIR(Color::Yellow));
+                wattron(win, COLOR_PAIR(Color::Yellow));
+                mvwaddch(win, row, leftCol + cols - 1, '|');
+                wattroff(win, COLOR_PAIR(Color::Yellow));
             }
             else {
-                mvaddch(row, leftCol + cols - 1, '|');
+                mvwaddch(win, row, leftCol + cols - 1, '|');
             }
         }
 
-        move(rows - 2, leftCol + cols / 2);
+        wmove(win, rows - 2, leftCol + cols / 2);
         if (top + maxDisplay < count) {
-            printw("v");
+            wprintw(win, "v");
         }
         else {
-            printw(" ");    
+            wprintw(win, " ");    
         }
 
-        refresh();
+        wrefresh(win);
 
         int ch;
         do {
-            ch = getch();
+            ch = wgetch(win);
         } while (ch != KEY_UP && ch != KEY_DOWN && ch != '?' && ch != 27);
 
         switch (ch) {
@@ -1650,8 +1416,7 @@ void commandList() {
 
             case '?':
             case 27:
-                clear();
-                printDungeon();
+                closePanel(win);
                 return;
         }
     }
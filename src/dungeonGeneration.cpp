@@ -4,42 +4,99 @@
 #include <cstring>
 
 #include "dungeon.hpp"
+#include "entityList.hpp"
+#include "floorIndex.hpp"
+#include "generator.hpp"
 #include "pathFinding.hpp"
 #include "perlin.hpp"
+#include "spawnTable.hpp"
+#include "trace.hpp"
 
-Tile dungeon[MAX_HEIGHT][MAX_WIDTH];
+int dungeonWidth = DEFAULT_WIDTH;
+int dungeonHeight = DEFAULT_HEIGHT;
+Grid<Tile> dungeon(DEFAULT_WIDTH, DEFAULT_HEIGHT);
 int roomCount;
 std::vector<Room> rooms;
 std::vector<Pos> upStairs;
 int upStairsCount;
 std::vector<Pos> downStairs;
 int downStairsCount;
+unsigned int nextEntityId = 0;
 
+// Before the player, whose inventory frees into them when the program ends
+std::unique_ptr<LevelArena> levelArena = std::make_unique<LevelArena>();
+std::unique_ptr<LevelArena> playerArena = std::make_unique<LevelArena>();
 Player player((Pos){-1, -1});
-std::unique_ptr<Monster> monsterAt[MAX_HEIGHT][MAX_WIDTH];
-std::vector<std::unique_ptr<Object>> objectsAt[MAX_HEIGHT][MAX_WIDTH];
+Grid<int> monsterIndex(DEFAULT_WIDTH, DEFAULT_HEIGHT, -1);
+Grid<int> pileHead(DEFAULT_WIDTH, DEFAULT_HEIGHT, -1);
+
+// floorSums[y][x] counts the FLOOR cells above row y and left of column x
+static Grid<int> floorSums(DEFAULT_WIDTH + 1, DEFAULT_HEIGHT + 1);
+// Set once a room is carved, the sums are rebuilt only when a lookup needs them
+static bool floorSumsStale = false;
+
+void resizeDungeon(int width, int height) {
+    clearAll();
+    dungeonWidth = width;
+    dungeonHeight = height;
+    dungeon.resize(width, height);
+    monsterIndex.resize(width, height, -1);
+    pileHead.resize(width, height, -1);
+    floorSums.resize(width + 1, height + 1);
+    terrainVersion++;
+}
+
+void buildFloorSums() {
+    for (int i = 0; i < dungeonHeight; i++) {
+        int rowSum = 0;
+        for (int j = 0; j < dungeonWidth; j++) {
+            rowSum += dungeon[i][j].type == FLOOR;
+            floorSums[i + 1][j + 1] = floorSums[i][j + 1] + rowSum;
+        }
+    }
+    floorSumsStale = false;
+}
+
+int floorInRect(int x, int y, int width, int height) {
+    if (floorSumsStale) {
+        buildFloorSums();
+    }
+    return floorSums[y + height][x + width] - floorSums[y][x + width] - floorSums[y + height][x] + floorSums[y][x];
+}
 
 void initDungeon() {
+    TraceSpan span("initDungeon", "generation");
+    terrainVersion++;
     generateHardness();
 
-    for (int i = 0; i < MAX_HEIGHT; i++) {
-        for (int j = 0; j < MAX_WIDTH; j++) {
-            if (i == 0 || i == MAX_HEIGHT - 1 || j == 0 || j == MAX_WIDTH - 1) {
+    for (int i = 0; i < dungeonHeight; i++) {
+        for (int j = 0; j < dungeonWidth; j++) {
+            if (i == 0 || i == dungeonHeight - 1 || j == 0 || j == dungeonWidth - 1) {
                 dungeon[i][j].hardness = MAX_HARDNESS;
             }
             dungeon[i][j].type = ROCK;
+            dungeon[i][j].visible = FOG;
         }
     }
+    buildFloorSums();
 }
 
-int placeRoom(Room& room) {
-    for (int i = room.getPos().y - 1; i < room.getPos().y + room.getHeight() + 1; i++) {
-        for (int j = room.getPos().x - 1; j < room.getPos().x + room.getWidth() + 1; j++) {
-            if (dungeon[i][j].type == FLOOR) {
-                return 0;
-            }
+// The same count cell by cell, for one small rectangle it beats rebuilding the sums
+int countFloor(int x, int y, int width, int height) {
+    int count = 0;
+    for (int i = y; i < y + height; i++) {
+        for (int j = x; j < x + width; j++) {
+            count += dungeon[i][j].type == FLOOR;
         }
     }
+    return count;
+}
+
+int placeRoom(Room& room) {
+    // A room needs a one cell margin of non-floor around it
+    if (countFloor(room.getPos().x - 1, room.getPos().y - 1, room.getWidth() + 2, room.getHeight() + 2) != 0) {
+        return 0;
+    }
 
     for (int i = room.getPos().y; i < room.getPos().y + room.getHeight(); i++) {
         for (int j = room.getPos().x; j < room.getPos().x + room.getWidth(); j++) {
@@ -47,75 +104,118 @@ int placeRoom(Room& room) {
             dungeon[i][j].hardness = 0;
         }
     }
+    floorSumsStale = true;
 
     return 1;
 }
 
 int buildRooms() {
+    TraceSpan span("buildRooms", "generation");
     rooms.reserve(roomCount);
+
+    // Placing rooms only ever adds floor, so a size that fits nowhere never fits again
+    bool noFit[13][13] = {{false}};
+    std::vector<Pos> fits;
     for (int i = 0; i < roomCount; i++) {
         for (int j = 0; j < ATTEMPTS; j++) {
             int width = rand() % 9 + 4;
             int height = rand() % 10 + 3;
-            int x = rand() % (MAX_WIDTH - width - 1) + 1;
-            int y = rand() % (MAX_HEIGHT - height - 1) + 1;
-           
-            Room room = Room((Pos){x, y}, width, height);
-            if (placeRoom(room)) {
-                rooms.emplace_back(room);
-                break;
+            if (noFit[height][width]) {
+                continue;
+            }
+
+            // A few random spots cost the room's size each, whatever the map's
+            Pos at = {-1, -1};
+            for (int k = 0; k < ROOM_SAMPLES && at.x == -1; k++) {
+                int x = rand() % (dungeonWidth - width - 1) + 1;
+                int y = rand() % (dungeonHeight - height - 1) + 1;
+                if (countFloor(x - 1, y - 1, width + 2, height + 2) == 0) {
+                    at = (Pos){x, y};
+                }
+            }
+
+            // Once they keep missing the map is filling up, every position with an empty margin is listed
+            if (at.x == -1) {
+                fits.clear();
+                for (int y = 1; y < dungeonHeight - height; y++) {
+                    for (int x = 1; x < dungeonWidth - width; x++) {
+                        if (floorInRect(x - 1, y - 1, width + 2, height + 2) == 0) {
+                            fits.push_back((Pos){x, y});
+                        }
+                    }
+                }
+                if (fits.empty()) {
+                    noFit[height][width] = true;
+                    continue;
+                }
+                at = fits[rand() % fits.size()];
             }
+
+            Room room = Room(at, width, height);
+            placeRoom(room);
+            rooms.emplace_back(room);
+            break;
         }
     }
+
+    // Corridors and stairs index rooms by roomCount, keep it honest when the map fills up
+    roomCount = rooms.size();
     return 0;
 }
 
-void buildCorridors() {
-    for (int i = 0 ; i < roomCount - 1; i++) {
-        int x = rand() % (rooms[i].getWidth() - 2) + rooms[i].getPos().x + 1;
-        int y = rand() % (rooms[i].getHeight() - 2) + rooms[i].getPos().y + 1;
-        int x2 = rand() % (rooms[i + 1].getWidth() - 2) + rooms[i + 1].getPos().x + 1;
-        int y2 = rand() % (rooms[i + 1].getHeight() - 2) + rooms[i + 1].getPos().y + 1;
+// Wanders from a random spot in one room to a random spot in the other, so it always arrives
+void digCorridor(Room& from, Room& to) {
+    int x = rand() % (from.getWidth() - 2) + from.getPos().x + 1;
+    int y = rand() % (from.getHeight() - 2) + from.getPos().y + 1;
+    int x2 = rand() % (to.getWidth() - 2) + to.getPos().x + 1;
+    int y2 = rand() % (to.getHeight() - 2) + to.getPos().y + 1;
 
-        int xDir = (x2 - x > 0) ? 1 : -1;
-        int yDir = (y2 - y > 0) ? 1 : -1;
+    int xDir = (x2 - x > 0) ? 1 : -1;
+    int yDir = (y2 - y > 0) ? 1 : -1;
 
-        while (x != x2 && y != y2) {
-            int dir = rand() % 5;
+    while (x != x2 && y != y2) {
+        int dir = rand() % 5;
 
-            if (dir == 0) {
-                if (dungeon[y][x].type != FLOOR) {
-                    dungeon[y][x].type = CORRIDOR;
-                    dungeon[y][x].hardness = 0;
-                }
-                y += yDir;
-            } 
-            else {
-                if (dungeon[y][x].type != FLOOR) {
-                    dungeon[y][x].type = CORRIDOR;
-                    dungeon[y][x].hardness = 0;
-                }
-                x += xDir;
+        if (dir == 0) {
+            if (dungeon[y][x].type != FLOOR) {
+                dungeon[y][x].type = CORRIDOR;
+                dungeon[y][x].hardness = 0;
             }
-        }
-        while (x != x2) {
+            y += yDir;
+        } 
+        else {
             if (dungeon[y][x].type != FLOOR) {
-                    dungeon[y][x].type = CORRIDOR;
-                    dungeon[y][x].hardness = 0;
-                }
+                dungeon[y][x].type = CORRIDOR;
+                dungeon[y][x].hardness = 0;
+            }
             x += xDir;
         }
-        while (y != y2) {
-            if (dungeon[y][x].type != FLOOR) {
-                    dungeon[y][x].type = CORRIDOR;
-                    dungeon[y][x].hardness = 0;
-                }
-            y += yDir;
-        }
+    }
+    while (x != x2) {
+        if (dungeon[y][x].type != FLOOR) {
+                dungeon[y][x].type = CORRIDOR;
+                dungeon[y][x].hardness = 0;
+            }
+        x += xDir;
+    }
+    while (y != y2) {
+        if (dungeon[y][x].type != FLOOR) {
+                dungeon[y][x].type = CORRIDOR;
+                dungeon[y][x].hardness = 0;
+            }
+        y += yDir;
+    }
+}
+
+void buildCorridors() {
+    TraceSpan span("buildCorridors", "generation");
+    for (int i = 0 ; i < roomCount - 1; i++) {
+        digCorridor(rooms[i], rooms[i + 1]);
     }
 }
 
 int buildStairs() {
+    TraceSpan span("buildStairs", "generation");
     int xUp = rand() % rooms.front().getWidth() + rooms.front().getPos().x;
     int yUp = rand() % rooms.front().getHeight() + rooms.front().getPos().y;
     upStairsCount = 1;
@@ -131,86 +231,82 @@ int buildStairs() {
     return 0;
 }
 
-void spawnPlayer() {
-    int x, y;
-    bool valid = false;
-    while (!valid) {
-        x = rand() % (rooms[rand() % roomCount].getWidth() - 2) + rooms[rand() % roomCount].getPos().x + 1;
-        y = rand() % (rooms[rand() % roomCount].getHeight() - 2) + rooms[rand() % roomCount].getPos().y + 1;
-        if (dungeon[y][x].type == FLOOR) {
-            valid = true;
-        }
-        else {
-            continue;
-        }
+// Built over the rooms plus the floor outside them. Monster spawning takes cells out as they fill, so
+// it marks the index stale for the next caller
+static FloorIndex floorIndex;
+static unsigned int floorIndexVersion;
+static bool floorIndexValid = false;
+
+static FloorIndex& currentFloorIndex() {
+    if (!floorIndexValid || floorIndexVersion != terrainVersion) {
+        floorIndex.build(rooms, true);
+        floorIndexVersion = terrainVersion;
+        floorIndexValid = true;
+    }
+    return floorIndex;
+}
 
-        for (int i = 0; i < upStairsCount; i++) {
-            for (int j = 0; j < roomCount; j++) {
-                if (upStairs[i].x >= rooms[j].getPos().x && upStairs[i].x < rooms[j].getPos().x + rooms[j].getWidth() &&
-                    upStairs[i].y >= rooms[j].getPos().y && upStairs[i].y < rooms[j].getPos().y + rooms[j].getHeight() &&
-                    x >= rooms[j].getPos().x && x < rooms[j].getPos().x + rooms[j].getWidth() &&
-                    y >= rooms[j].getPos().y && y < rooms[j].getPos().y + rooms[j].getHeight()) {
-                        valid = false;
-                    }
-            }
+void spawnPlayer() {
+    TraceSpan span("spawnPlayer", "generation");
+    FloorIndex& index = currentFloorIndex();
+
+    // Any room but one holding stairs, unless every room does
+    std::vector<bool> allowed(index.groupCount(), true);
+    allowed.back() = false;
+    for (Pos stair : upStairs) {
+        if (index.groupAt(stair) != -1) {
+            allowed[index.groupAt(stair)] = false;
         }
-        for (int i = 0; i < downStairsCount; i++) {
-            for (int j = 0; j < roomCount; j++) {
-                if (downStairs[i].x >= rooms[j].getPos().x && downStairs[i].x < rooms[j].getPos().x + rooms[j].getWidth() &&
-                    downStairs[i].y >= rooms[j].getPos().y && downStairs[i].y < rooms[j].getPos().y + rooms[j].getHeight() &&
-                    x >= rooms[j].getPos().x && x < rooms[j].getPos().x + rooms[j].getWidth() &&
-                    y >= rooms[j].getPos().y && y < rooms[j].getPos().y + rooms[j].getHeight()) {
-                        valid = false;
-                    }
-            }
+    }
+    for (Pos stair : downStairs) {
+        if (index.groupAt(stair) != -1) {
+            allowed[index.groupAt(stair)] = false;
         }
     }
+    Pos at = index.sample(allowed);
+    if (at.x == -1) {
+        allowed.assign(index.groupCount(), true);
+        allowed.back() = false;
+        at = index.sample(allowed);
+    }
 
-    player.setPos((Pos){x, y});
+    player.setPos(at);
 }
 
 int spawnMonsters(int numMonsters, int playerX, int playerY) {
-    int monsterTypeListSize = monsterTypeList.size();
+    TraceSpan span("spawnMonsters", "generation");
+    FloorIndex& index = currentFloorIndex();
+    floorIndexValid = false;
+
+    std::vector<bool> allowed(index.groupCount(), true);
+    allowed.back() = false;
+    if (index.groupAt((Pos){playerX, playerY}) != -1) {
+        allowed[index.groupAt((Pos){playerX, playerY})] = false;
+    }
 
     for (int i = 0; i < numMonsters; i++) {
-        for (int j = 0; j < ATTEMPTS; j++) {
-            int placed = 0;
-            int x = rand() % (MAX_WIDTH - 2) + 1;
-            int y = rand() % (MAX_HEIGHT - 2) + 1;
-            if (dungeon[y][x].type != FLOOR) {
-                continue;
-            }
-            for (int k = 0; k < roomCount; k++) {
-                if ((playerX >= rooms[k].getPos().x && playerX <= rooms[k].getPos().x + rooms[k].getWidth() - 1 &&
-                    playerY >= rooms[k].getPos().y && playerY <= rooms[k].getPos().y + rooms[k].getHeight() - 1)) {
-                    continue;
-                }
-                else if (x >= rooms[k].getPos().x && x <= rooms[k].getPos().x + rooms[k].getWidth() - 1 &&
-                         y >= rooms[k].getPos().y && y <= rooms[k].getPos().y + rooms[k].getHeight() - 1) {
-                    if (monsterAt[y][x]) {
-                        continue;
-                    }
-
-                    int monTypeIndex = rand() % monsterTypeListSize;
-                    MonsterType *monType = &monsterTypeList[monTypeIndex];
-                    int rarityCheck = rand() % 100 + 1;
-                    if (rarityCheck >= monType->rarity || !monType->eligible || !monType->valid) {
-                        continue;
-                    }
-                    
-                    monsterAt[y][x] = std::make_unique<Monster>(monType, monTypeIndex, (Pos){x, y});
-                    placed = 1;
-                    if (monsterAt[y][x].get()->isUnique() || monsterAt[y][x].get()->isBoss()) {
-                        monsterTypeList[monTypeIndex].eligible = false;
-                    }
-
-                    break;
-                }
-            }
+        // A cell found taken is dropped, so each cell is drawn at most once over the whole call
+        Pos at = index.sample(allowed);
+        while (at.x != -1 && monsterAt[at.y][at.x]) {
+            index.remove(at);
+            at = index.sample(allowed);
+        }
+        if (at.x == -1) {
+            return 0;
+        }
 
-            if (placed) {
-                break;
-            }
+        int monTypeIndex = pickMonsterType();
+        if (monTypeIndex == -1) {
+            return 0;
+        }
+        MonsterType *monType = &monsterTypeList[monTypeIndex];
+
+        Monster *mon = new Monster(monType, monTypeIndex, at);
+        placeMonster(mon);
+        trackMonster(mon);
+        index.remove(at);
+        if (mon->isUnique() || mon->isBoss()) {
+            setMonsterEligible(monTypeIndex, false);
         }
     }
 
@@ -218,40 +314,40 @@ int spawnMonsters(int numMonsters, int playerX, int playerY) {
 }
 
 int spawnObjects(int numObjects) {
-    int objectTypeListSize = objectTypeList.size();
-
-    for (int i = 0; i < numObjects; i++) {
-        for (int j = 0; j < ATTEMPTS; j++) {
-            int x = rand() % MAX_WIDTH;
-            int y = rand() % MAX_HEIGHT;
-            if (dungeon[y][x].type != FLOOR || (player.getPos().x == x && player.getPos().y == y)) {
-                continue;
-            }
-            
-            int objTypeIndex = rand() % objectTypeListSize;
-            ObjectType *objType = &objectTypeList[objTypeIndex];
-            int rarityCheck = rand() % 100;
-            if (rarityCheck >= objType->rarity || !objType->eligible || !objType->valid) {
-                continue;
-            }
+    TraceSpan span("spawnObjects", "generation");
+    FloorIndex& index = currentFloorIndex();
+    floorIndexValid = false;
 
+    // Objects stack, so only the player's cell leaves the pool
+    index.remove(player.getPos());
+    std::vector<bool> allowed(index.groupCount(), true);
 
-            objectsAt[y][x].emplace_back(std::make_unique<Object>(objType, objTypeIndex, (Pos){x, y}));
-            if (objectsAt[y][x].back().get()->isArtifact()) {
-                objectTypeList[objTypeIndex].eligible = false;
-            }
+    for (int i = 0; i < numObjects; i++) {
+        Pos at = index.sample(allowed);
+        if (at.x == -1) {
+            return 0;
+        }
 
-            break;
+        int objTypeIndex = pickObjectType();
+        if (objTypeIndex == -1) {
+            return 0;
         }
+        ObjectType *objType = &objectTypeList[objTypeIndex];
 
+        Object *obj = new Object(objType, objTypeIndex, at);
+        placeObject(obj);
+        trackObject(obj);
+        if (obj->isArtifact()) {
+            setObjectEligible(objTypeIndex, false);
+        }
     }
 
     return 0;
 }
 
 void printHardness() {
-    for (int i = 0; i < MAX_HEIGHT; i++) {
-        for (int j = 0; j < MAX_WIDTH; j++) {
+    for (int i = 0; i < dungeonHeight; i++) {
+        for (int j = 0; j < dungeonWidth; j++) {
             int h = dungeon[i][j].hardness;
             if (h < 1) {
                 printf(" ");
@@ -277,26 +373,28 @@ void printHardness() {
 }
 
 int generateStructures() {
+    TraceSpan span("generateStructures", "generation");
     roomCount = rand() % 5 + 7;
-    buildRooms();
-    buildCorridors();
+    generator->generate();
     buildStairs();
+    terrainVersion++;
 
     return 0;
 }
 
 void clearAll() {
+    clearRosters();
     rooms.clear();
     upStairs.clear();
-    for (int i = 0; i < MAX_HEIGHT; i++) {
-        for (int j = 0; j < MAX_WIDTH; j++) {
-            monsterAt[i][j] = nullptr;
-        }
+    downStairs.clear();
+    // Only the cells the stores name are touched, and the arena drops the entities all at once
+    for (Pos pos : monsterStore.pos) {
+        monsterIndex[pos.y][pos.x] = -1;
     }
-
-    for (int i = 0; i < MAX_HEIGHT; i++) {
-        for (int j = 0; j < MAX_WIDTH; j++) {
-            objectsAt[i][j].clear();
-        }
+    for (Pos pos : objectStore.pos) {
+        pileHead[pos.y][pos.x] = -1;
     }
+    monsterStore.clear();
+    objectStore.clear();
+    levelArena->release();
 }
@@ -0,0 +1,171 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+
+#include "dungeon.hpp"
+#include "entityArena.hpp"
+
+// A released level runs no destructors, so nothing an entity holds may need one. Monsters carry
+// equipment and inventory slots, which stay empty since monsters never pick anything up
+static_assert(std::is_trivially_destructible<Object>::value, "objects are dropped without destructors");
+
+static const size_t SLOT_ALIGN = alignof(std::max_align_t);
+// Room for the owner pointer at the start of each slab, rounded so slots stay aligned
+static const size_t SLAB_HEADER = (sizeof(SlotArena *) + SLOT_ALIGN - 1) / SLOT_ALIGN * SLOT_ALIGN;
+
+// Slabs a released arena handed back, reused before asking malloc. A plain array, so it is still
+// there for arenas torn down at exit
+static const int MAX_SPARE_SLABS = 16;
+static char *spareSlabs[MAX_SPARE_SLABS];
+static int spareSlabCount = 0;
+
+ArenaStats arenaStats;
+
+SlotArena::SlotArena(size_t slotSize) : slotSize((slotSize + SLOT_ALIGN - 1) / SLOT_ALIGN * SLOT_ALIGN) {}
+
+static void dropSlab(char *slab) {
+    if (spareSlabCount < MAX_SPARE_SLABS) {
+        spareSlabs[spareSlabCount++] = slab;
+    }
+    else {
+        std::free(slab);
+    }
+}
+
+SlotArena::~SlotArena() {
+    arenaStats.bulkFreed += live;
+    arenaStats.live -= live;
+    for (char *slab : slabs) {
+        dropSlab(slab);
+    }
+}
+
+void SlotArena::addSlab() {
+    char *slab;
+    if (spareSlabCount > 0) {
+        slab = spareSlabs[--spareSlabCount];
+    }
+    else {
+        slab = static_cast<char *>(aligned_alloc(SLAB_BYTES, SLAB_BYTES));
+        if (slab == nullptr) {
+            throw std::bad_alloc();
+        }
+        arenaStats.slabsAllocated++;
+    }
+    *reinterpret_cast<SlotArena **>(slab) = this;
+    slabs.push_back(slab);
+    next = slab + SLAB_HEADER;
+    end = slab + SLAB_BYTES;
+}
+
+void *SlotArena::allocate(size_t size) {
+    if (size > slotSize) {
+        throw std::bad_alloc();
+    }
+    void *slot;
+    if (freeList != nullptr) {
+        slot = freeList;
+        freeList = *static_cast<void **>(freeList);
+    }
+    else {
+        if (next == nullptr || next + slotSize > end) {
+            addSlab();
+        }
+        slot = next;
+        next += slotSize;
+    }
+    live++;
+    arenaStats.allocations++;
+    arenaStats.live++;
+    if (arenaStats.live > arenaStats.peakLive) {
+        arenaStats.peakLive = arenaStats.live;
+    }
+    return slot;
+}
+
+void SlotArena::free(void *slot) {
+    if (slot == nullptr) {
+        return;
+    }
+    char *slab = reinterpret_cast<char *>(reinterpret_cast<uintptr_t>(slot) & ~static_cast<uintptr_t>(SLAB_BYTES - 1));
+    SlotArena *arena = *reinterpret_cast<SlotArena **>(slab);
+    *static_cast<void **>(slot) = arena->freeList;
+    arena->freeList = slot;
+    arena->live--;
+    arenaStats.frees++;
+    arenaStats.live--;
+}
+
+void SlotArena::release() {
+    arenaStats.bulkFreed += live;
+    arenaStats.live -= live;
+    live = 0;
+    freeList = nullptr;
+    if (slabs.empty()) {
+        return;
+    }
+    for (size_t i = 1; i < slabs.size(); i++) {
+        dropSlab(slabs[i]);
+    }
+    slabs.resize(1);
+    next = slabs.front() + SLAB_HEADER;
+    end = slabs.front() + SLAB_BYTES;
+}
+
+LevelArena::LevelArena() : monsters(sizeof(Monster)), objects(sizeof(Object)) {}
+
+void LevelArena::release() {
+    monsters.release();
+    objects.release();
+    arenaStats.bulkReleases++;
+}
+
+std::unique_ptr<LevelArena> takeLevelArena() {
+    std::unique_ptr<LevelArena> taken = std::move(levelArena);
+    levelArena = std::make_unique<LevelArena>();
+    return taken;
+}
+
+void *Monster::operator new(size_t size) {
+    return levelArena->monsters.allocate(size);
+}
+
+void *Monster::operator new(size_t size, LevelArena& arena) {
+    return arena.monsters.allocate(size);
+}
+
+void Monster::operator delete(void *slot) {
+    SlotArena::free(slot);
+}
+
+void Monster::operator delete(void *slot, LevelArena&) {
+    SlotArena::free(slot);
+}
+
+void *Object::operator new(size_t size) {
+    return levelArena->objects.allocate(size);
+}
+
+void *Object::operator new(size_t size, LevelArena& arena) {
+    return arena.objects.allocate(size);
+}
+
+void Object::operator delete(void *slot) {
+    SlotArena::free(slot);
+}
+
+void Object::operator delete(void *slot, LevelArena&) {
+    SlotArena::free(slot);
+}
+
+void printArenaStats() {
+    printf("\n%-22s %10s\n", "entity arenas", "total");
+    printf("%-22s %10ld\n", "allocations", arenaStats.allocations);
+    printf("%-22s %10ld\n", "single frees", arenaStats.frees);
+    printf("%-22s %10ld\n", "freed with level", arenaStats.bulkFreed);
+    printf("%-22s %10ld\n", "level releases", arenaStats.bulkReleases);
+    printf("%-22s %10ld\n", "slabs allocated", arenaStats.slabsAllocated);
+    printf("%-22s %10ld\n", "peak live entities", arenaStats.peakLive);
+}
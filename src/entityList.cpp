@@ -0,0 +1,59 @@
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+
+#include "dungeon.hpp"
+#include "entityList.hpp"
+
+std::vector<Monster *> monsterRoster;
+std::vector<Object *> objectRoster;
+
+static int distance(Pos a, Pos b) {
+    return std::max(abs(a.x - b.x), abs(a.y - b.y));
+}
+
+// Sorted on keys worked out once per entity, ties broken by entity id so the order is total. The
+// previous order is no help once the player has crossed the map, so this stays n log n either way
+template <typename T>
+static void sortByDistance(std::vector<T *>& roster, Pos from) {
+    std::vector<std::pair<std::pair<int, unsigned int>, T *>> keyed(roster.size());
+    for (size_t i = 0; i < roster.size(); i++) {
+        keyed[i] = std::make_pair(std::make_pair(distance(roster[i]->getPos(), from), roster[i]->getEntityId()), roster[i]);
+    }
+    std::sort(keyed.begin(), keyed.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    for (size_t i = 0; i < roster.size(); i++) {
+        roster[i] = keyed[i].second;
+    }
+}
+
+void sortRosters(Pos from) {
+    sortByDistance(monsterRoster, from);
+    sortByDistance(objectRoster, from);
+}
+
+void trackMonster(Monster *mon) {
+    monsterRoster.push_back(mon);
+}
+
+void untrackMonster(Monster *mon) {
+    monsterRoster.erase(std::find(monsterRoster.begin(), monsterRoster.end(), mon));
+}
+
+void trackObject(Object *obj) {
+    objectRoster.push_back(obj);
+}
+
+void untrackObject(Object *obj) {
+    objectRoster.erase(std::find(objectRoster.begin(), objectRoster.end(), obj));
+}
+
+void clearRosters() {
+    monsterRoster.clear();
+    objectRoster.clear();
+}
+
+// Name, wrapped ability lines (four per line) and location
+int monsterRowCount(Monster *mon) {
+    int abilityCount = monsterTypeList[mon->getMonTypeIndex()].abils.size();
+    return 2 + (abilityCount <= 0 ? 1 : (abilityCount + 3) / 4);
+}
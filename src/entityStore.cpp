@@ -0,0 +1,128 @@
+#include "dungeon.hpp"
+
+MonsterStore monsterStore;
+ObjectStore objectStore;
+MonsterMap monsterAt;
+PileMap objectsAt;
+
+int MonsterStore::add(Monster *mon) {
+    entities.push_back(mon);
+    pos.push_back(mon->getPos());
+    speed.push_back(mon->getSpeed());
+    flags.push_back(mon->getAbilities());
+    return entities.size() - 1;
+}
+
+Monster *MonsterStore::remove(int slot) {
+    int last = entities.size() - 1;
+    Monster *moved = slot == last ? nullptr : entities[last];
+    entities[slot] = entities[last];
+    pos[slot] = pos[last];
+    speed[slot] = speed[last];
+    flags[slot] = flags[last];
+    entities.pop_back();
+    pos.pop_back();
+    speed.pop_back();
+    flags.pop_back();
+    return moved;
+}
+
+void MonsterStore::clear() {
+    entities.clear();
+    pos.clear();
+    speed.clear();
+    flags.clear();
+}
+
+int ObjectStore::add(Object *obj) {
+    entities.push_back(obj);
+    pos.push_back(obj->getPos());
+    obj->setSlot(entities.size() - 1);
+    return obj->getSlot();
+}
+
+Object *ObjectStore::remove(int slot) {
+    int last = entities.size() - 1;
+    Object *moved = slot == last ? nullptr : entities[last];
+    entities[slot] = entities[last];
+    pos[slot] = pos[last];
+    entities[slot]->setSlot(slot);
+    entities.pop_back();
+    pos.pop_back();
+    return moved;
+}
+
+void ObjectStore::clear() {
+    entities.clear();
+    pos.clear();
+}
+
+void placeMonster(Monster *mon) {
+    Pos pos = mon->getPos();
+    monsterIndex[pos.y][pos.x] = monsterStore.add(mon);
+}
+
+void moveMonster(Monster *mon, Pos to) {
+    Pos from = mon->getPos();
+    int slot = monsterIndex[from.y][from.x];
+    monsterIndex[from.y][from.x] = -1;
+    monsterIndex[to.y][to.x] = slot;
+    monsterStore.pos[slot] = to;
+    mon->setPos(to);
+}
+
+void swapMonsters(Monster *a, Monster *b) {
+    Pos aPos = a->getPos();
+    Pos bPos = b->getPos();
+    int aSlot = monsterIndex[aPos.y][aPos.x];
+    int bSlot = monsterIndex[bPos.y][bPos.x];
+    monsterIndex[aPos.y][aPos.x] = bSlot;
+    monsterIndex[bPos.y][bPos.x] = aSlot;
+    monsterStore.pos[aSlot] = bPos;
+    monsterStore.pos[bSlot] = aPos;
+    a->setPos(bPos);
+    b->setPos(aPos);
+}
+
+void liftMonster(Monster *mon) {
+    Pos pos = mon->getPos();
+    int slot = monsterIndex[pos.y][pos.x];
+    monsterIndex[pos.y][pos.x] = -1;
+    Monster *moved = monsterStore.remove(slot);
+    if (moved != nullptr) {
+        monsterIndex[moved->getPos().y][moved->getPos().x] = slot;
+    }
+}
+
+void removeMonster(Monster *mon) {
+    liftMonster(mon);
+    delete mon;
+}
+
+void placeObject(Object *obj) {
+    int& head = pileHead[obj->getPos().y][obj->getPos().x];
+    obj->setBelow(objectsAt[obj->getPos().y][obj->getPos().x].back());
+    head = objectStore.add(obj);
+}
+
+void liftObject(Object *obj) {
+    Pos pos = obj->getPos();
+    int slot = obj->getSlot();
+    if (pileHead[pos.y][pos.x] == slot) {
+        pileHead[pos.y][pos.x] = obj->getBelow() == nullptr ? -1 : obj->getBelow()->getSlot();
+    }
+    else {
+        Object *above = objectStore.entities[pileHead[pos.y][pos.x]];
+        while (above->getBelow() != obj) {
+            above = above->getBelow();
+        }
+        above->setBelow(obj->getBelow());
+    }
+    obj->setBelow(nullptr);
+
+    Object *moved = objectStore.remove(slot);
+    if (moved != nullptr && pileHead[moved->getPos().y][moved->getPos().x] == objectStore.size()) {
+        pileHead[moved->getPos().y][moved->getPos().x] = slot;
+    }
+    obj->setSlot(-1);
+}
@@ -3,8 +3,10 @@
 
 #include "dungeon.hpp"
 #include "fibonacciHeap.hpp"
+#include "profiler.hpp"
 
 FibNode* FibHeap::insertNew(int key, Pos pos) {
+    countEvent(Counter::HeapOps);
     nodes.emplace_back(std::make_unique<FibNode>(key, pos));
     FibNode *node = nodes.back().get();
 
@@ -27,6 +29,7 @@ FibNode* FibHeap::insertNew(int key, Pos pos) {
 }
 
 FibNode* FibHeap::insertNode(FibNode *node) {
+    countEvent(Counter::HeapOps);
     node->setParent(nullptr);
     node->setChild(nullptr);
     node->setLeft(node);
@@ -140,6 +143,7 @@ FibNode* FibHeap::getMin() {
 }
 
 FibNode* FibHeap::extractMin() {
+    countEvent(Counter::HeapOps);
     FibNode *minNode = min;
 
     if (minNode != nullptr) {
@@ -222,6 +226,7 @@ void FibHeap::cascadingCut(FibNode *node) {
 }
 
 void FibHeap::decreaseKey(FibNode *node, int newKey) {
+    countEvent(Counter::HeapOps);
     if (newKey > node->getKey()) {
         return;
     }
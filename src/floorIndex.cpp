@@ -0,0 +1,89 @@
+#include <cstdlib>
+
+#include "floorIndex.hpp"
+#include "trace.hpp"
+
+void FloorIndex::build(std::vector<Room>& fromRooms, bool outside) {
+    TraceSpan span("build floor index", "generation");
+    if (slot.getWidth() != dungeonWidth || slot.getHeight() != dungeonHeight) {
+        slot.resize(dungeonWidth, dungeonHeight);
+        groupOf.resize(dungeonWidth, dungeonHeight);
+    }
+    slot.fill(-1);
+    groupOf.fill(-1);
+    groups.assign(fromRooms.size() + (outside ? 1 : 0), std::vector<Pos>());
+
+    for (size_t r = 0; r < fromRooms.size(); r++) {
+        Room& room = fromRooms[r];
+        std::vector<Pos>& cells = groups[r];
+        for (int y = room.getPos().y; y < room.getPos().y + room.getHeight(); y++) {
+            for (int x = room.getPos().x; x < room.getPos().x + room.getWidth(); x++) {
+                if (groupOf[y][x] != -1) {
+                    continue;
+                }
+                groupOf[y][x] = r;
+                if (dungeon[y][x].type == FLOOR) {
+                    slot[y][x] = cells.size();
+                    cells.push_back((Pos){x, y});
+                }
+            }
+        }
+    }
+
+    if (outside) {
+        std::vector<Pos>& cells = groups.back();
+        for (int y = 0; y < dungeonHeight; y++) {
+            for (int x = 0; x < dungeonWidth; x++) {
+                if (groupOf[y][x] == -1 && dungeon[y][x].type == FLOOR) {
+                    slot[y][x] = cells.size();
+                    cells.push_back((Pos){x, y});
+                }
+            }
+        }
+    }
+}
+
+void FloorIndex::remove(Pos pos) {
+    int at = slot[pos.y][pos.x];
+    if (at == -1) {
+        return;
+    }
+    int group = groupOf[pos.y][pos.x] == -1 ? groups.size() - 1 : groupOf[pos.y][pos.x];
+    std::vector<Pos>& cells = groups[group];
+    Pos last = cells.back();
+    cells[at] = last;
+    slot[last.y][last.x] = at;
+    cells.pop_back();
+    slot[pos.y][pos.x] = -1;
+}
+
+int FloorIndex::groupAt(Pos pos) const {
+    if (pos.x < 0 || pos.y < 0 || pos.x >= slot.getWidth() || pos.y >= slot.getHeight()) {
+        return -1;
+    }
+    return groupOf[pos.y][pos.x];
+}
+
+Pos FloorIndex::sample(const std::vector<bool>& allowed) const {
+    int total = 0;
+    for (size_t g = 0; g < groups.size(); g++) {
+        if (allowed[g]) {
+            total += groups[g].size();
+        }
+    }
+    if (total == 0) {
+        return (Pos){-1, -1};
+    }
+
+    int pick = rand() % total;
+    for (size_t g = 0; g < groups.size(); g++) {
+        if (!allowed[g]) {
+            continue;
+        }
+        if (pick < static_cast<int>(groups[g].size())) {
+            return groups[g][pick];
+        }
+        pick -= groups[g].size();
+    }
+    return (Pos){-1, -1};
+}
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cstdarg>
 #include <cstdio>
 #include <cstdlib>
@@ -14,48 +15,84 @@
 #include "fibonacciHeap.hpp"
 #include "game.hpp"
 #include "globals.hpp"
+#include "latency.hpp"
+#include "levelCache.hpp"
+#include "overlay.hpp"
+#include "overworld.hpp"
 #include "pathFinding.hpp"
+#include "profiler.hpp"
+#include "renderer.hpp"
+#include "trace.hpp"
 
 bool fogOfWarToggle = true;
 
-int checkCorridor(int x, int y, bool visited[MAX_HEIGHT][MAX_WIDTH]) {
-    if (x < 0 || x >= MAX_WIDTH || y < 0 || y >= MAX_HEIGHT) {
+// The field the last chasing monster followed. Erratic monsters check their random step against it,
+// as they did when every field was copied into the tiles
+static const DistanceField *lastField = nullptr;
+
+// Marks with the current stamp, so starting a new search costs nothing instead of clearing a map
+static Grid<unsigned int> corridorVisits;
+static unsigned int corridorStamp = 0;
+static std::vector<Pos> corridorStack;
+
+// Whether the corridor under (x, y) reaches the player, searched with an explicit stack so a long
+// corridor network cannot overflow the call stack
+int checkCorridor(int x, int y) {
+    if (dungeon[y][x].type != CORRIDOR) {
         return 0;
     }
-    else if ((visited[y][x] || dungeon[y][x].type != CORRIDOR)) {
-        return 0;
+    if (corridorVisits.getWidth() != dungeonWidth || corridorVisits.getHeight() != dungeonHeight) {
+        corridorVisits.resize(dungeonWidth, dungeonHeight);
+        corridorStamp = 0;
     }
-    else if (player.getPos().x == x && player.getPos().y == y) {
-        return 1;
+    if (++corridorStamp == 0) {
+        corridorVisits.fill(0);
+        corridorStamp = 1;
     }
-    visited[y][x] = true;
-
-    int directions[9][2] = {
-        {-1, 1}, {0, 1}, {1, 1},
-        {-1, 0}, {0, 0}, {1, 0},
-        {-1, -1}, {0, -1}, {1, -1}};
 
-    for (int i = 0; i < 9; i++) {
-        int newX = x + directions[i][0];
-        int newY = y + directions[i][1];
-        if (checkCorridor(newX, newY, visited)) {
+    corridorVisits[y][x] = corridorStamp;
+    corridorStack.clear();
+    corridorStack.push_back((Pos){x, y});
+    while (!corridorStack.empty()) {
+        Pos pos = corridorStack.back();
+        corridorStack.pop_back();
+        if (pos.x == player.getPos().x && pos.y == player.getPos().y) {
             return 1;
         }
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                int nx = pos.x + dx;
+                int ny = pos.y + dy;
+                if (nx < 0 || nx >= dungeonWidth || ny < 0 || ny >= dungeonHeight) {
+                    continue;
+                }
+                if (dungeon[ny][nx].type == CORRIDOR && corridorVisits[ny][nx] != corridorStamp) {
+                    corridorVisits[ny][nx] = corridorStamp;
+                    corridorStack.push_back((Pos){nx, ny});
+                }
+            }
+        }
     }
-
     return 0;
 }
 
-bool inLineOfSight(Pos pos) {
-    int visionRadius = BASE_VISION_RADIUS;
+int visionRadius() {
+    int radius = BASE_VISION_RADIUS;
     if (player.getEquipmentItem(Equip::Light) != nullptr) {
-        visionRadius += player.getEquipmentItem(Equip::Light)->getSpecialAttribute();
+        radius += player.getEquipmentItem(Equip::Light)->getSpecialAttribute();
     }
-    float effectiveRadius = visionRadius + 0.5f;
-    float xDist = static_cast<float>(pos.x - player.getPos().x);
-    float yDist = static_cast<float>(pos.y - player.getPos().y);
-    float dist = std::sqrt(xDist * xDist + yDist * yDist);
-    if (dist > effectiveRadius) {
+    return radius;
+}
+
+bool inLineOfSight(Pos pos) {
+    return inLineOfSight(pos, visionRadius());
+}
+
+bool inLineOfSight(Pos pos, int radius) {
+    // Within radius + 0.5, squared: dx^2 + dy^2 <= r^2 + r + 0.25 holds for integers iff <= r^2 + r
+    int xDist = pos.x - player.getPos().x;
+    int yDist = pos.y - player.getPos().y;
+    if (xDist * xDist + yDist * yDist > radius * radius + radius) {
         return false;
     }
 
@@ -96,10 +133,14 @@ bool inLineOfSight(Pos pos) {
 
 }
 
+// Only the square around the player can be in sight, so a turn costs the vision area, not the map
 void updateAroundPlayer() {
-    for (int y = 0; y < MAX_HEIGHT; y++) {
-        for (int x = 0; x < MAX_WIDTH; x++) {
-            if (inLineOfSight((Pos){x, y})) {
+    PhaseProbe probe(Phase::Fov);
+    int radius = visionRadius();
+    Pos at = player.getPos();
+    for (int y = std::max(at.y - radius, 0); y <= std::min(at.y + radius, dungeonHeight - 1); y++) {
+        for (int x = std::max(at.x - radius, 0); x <= std::min(at.x + radius, dungeonWidth - 1); x++) {
+            if (inLineOfSight((Pos){x, y}, radius)) {
                 dungeon[y][x].visible = dungeon[y][x].type;
             }
         }
@@ -114,14 +155,19 @@ int playGame() {
     std::unique_ptr<FibHeap> heap = std::make_unique<FibHeap>();
     std::unordered_map<Monster*, FibNode*> monMap;
 
-    for (int i = 0; i < MAX_HEIGHT; i++) {
-        for (int j = 0; j < MAX_WIDTH; j++) {
-            if (monsterAt[i][j]) {
-                Monster *mon = monsterAt[i][j].get();
-                monMap.insert(std::make_pair(mon, heap.get()->insertNew(1000 / mon->getSpeed(), mon->getPos())));
-            }
-            dungeon[i][j].visible = FOG;
-        }
+    // Queued in map order, so ties between equally fast monsters break by position
+    std::vector<int> order(monsterStore.size());
+    for (int i = 0; i < monsterStore.size(); i++) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [](int a, int b) {
+        Pos pa = monsterStore.pos[a];
+        Pos pb = monsterStore.pos[b];
+        return pa.y != pb.y ? pa.y < pb.y : pa.x < pb.x;
+    });
+    for (int slot : order) {
+        monMap.insert(std::make_pair(monsterStore.entities[slot],
+                                     heap.get()->insertNew(1000 / monsterStore.speed[slot], monsterStore.pos[slot])));
     }
     heap.get()->insertNew(1, player.getPos());
 
@@ -129,13 +175,23 @@ int playGame() {
         fogOfWarToggle = false;
     }
     while (1) {
-        FibNode *node = heap.get()->extractMin();
+        FibNode *node;
+        {
+            PhaseProbe probe(Phase::SchedulerPop);
+            node = heap.get()->extractMin();
+        }
         if (node == nullptr) {
             continue;
         }
         time = node->getKey();
 
         if (node->getPos() == player.getPos()) {
+            // Everything moved under the schedule, it is rebuilt like on a new level
+            if (overworldFlag && recenterOverworld()) {
+                return 1;
+            }
+            TraceSpan span("player turn", "turn");
+            endTurn();
             updateAroundPlayer();
             printDungeon();
             if (!actions.empty()) {
@@ -145,12 +201,15 @@ int playGame() {
             }
 
             bool turnEnd = false;
+            int64_t keyNanos = 0;
             while (!turnEnd) {
                 int ch = 0;
                 int xDir = 0;
                 int yDir = 0;
                 if (autoFlag) {
                     ch = getch();
+                    inputReceived();
+                    keyNanos = monotonicNanos();
                     if (ch == 'Q') {
                         printLine(MESSAGE_LINE, "Goodbye!");
                         napms(1000);
@@ -172,11 +231,14 @@ int playGame() {
                         FD_SET(STDIN_FILENO, &readfs);
                         tv.tv_sec = 0;
                         tv.tv_usec = 125000;
+                        checkLatencyDump();
                         redisplayColors();
-                        refresh();
+                        renderer->present();
                     } while (!select(STDIN_FILENO + 1, &readfs, nullptr, nullptr, &tv));
                     
                     ch = getch();
+                    inputReceived();
+                    keyNanos = monotonicNanos();
                     switch (ch) {
                         case KEY_HOME:
                         case '7':
@@ -252,32 +314,14 @@ int playGame() {
                         case '>':
                             if (dungeon[player.getPos().y][player.getPos().x].type == STAIR_DOWN) {
                                 printLine(MESSAGE_LINE, "Going down stairs...");
-                                napms(1000);
-
-                                for (int i = 0; i < MAX_HEIGHT; i++) {
-                                    for (int j = 0; j < MAX_WIDTH; j++) {
-                                        if (monsterAt[i][j]) {
-                                            if (monsterAt[i][j].get()->isBoss() || monsterAt[i][j].get()->isUnique()) {
-                                                monsterTypeList[monsterAt[i][j].get()->getMonTypeIndex()].eligible = true;
-                                            }
-                                        }
-                                        for (const auto& obj : objectsAt[i][j]) {
-                                            if (obj->isArtifact()) {
-                                                objectTypeList[obj->getObjTypeIndex()].eligible = true;
-                                            }
-                                        }
-                                    }
-                                }
-
-                                clearAll();
+                                TraceSpan span("level transition", "generation");
+                                levelTransitionStarted();
 
                                 clear();
-                                initDungeon();
-                                generateStructures();
-                                player.setPos((Pos){upStairs.back().x, upStairs.back().y});
-                                spawnMonsters(numMonsters, player.getPos().x, player.getPos().y);
-                                spawnObjects(numObjects);
-                                
+                                renderer->invalidate();
+                                leaveLevel();
+                                enterLevel(depth + 1, true);
+
                                 return 1;
                             }
                             else {
@@ -288,31 +332,13 @@ int playGame() {
                         case '<':
                             if (dungeon[player.getPos().y][player.getPos().x].type == STAIR_UP) {
                                 printLine(MESSAGE_LINE, "Going up stairs...");
-                                napms(1000);
-
-                                for (int i = 0; i < MAX_HEIGHT; i++) {
-                                    for (int j = 0; j < MAX_WIDTH; j++) {
-                                        if (monsterAt[i][j]) {
-                                            if (monsterAt[i][j].get()->isBoss() || monsterAt[i][j].get()->isUnique()) {
-                                                monsterTypeList[monsterAt[i][j].get()->getMonTypeIndex()].eligible = true;
-                                            }
-                                        }
-                                        for (const auto& obj : objectsAt[i][j]) {
-                                            if (obj->isArtifact()) {
-                                                objectTypeList[obj->getObjTypeIndex()].eligible = true;
-                                            }
-                                        }
-                                    }
-                                }
-
-                                clearAll();
+                                TraceSpan span("level transition", "generation");
+                                levelTransitionStarted();
 
                                 clear();
-                                initDungeon();
-                                generateStructures();
-                                player.setPos((Pos){downStairs.back().x, downStairs.back().y});
-                                spawnMonsters(numMonsters, player.getPos().x, player.getPos().y);
-                                spawnObjects(numObjects);
+                                renderer->invalidate();
+                                leaveLevel();
+                                enterLevel(depth - 1, false);
 
                                 return 1;
                             }
@@ -338,7 +364,7 @@ int playGame() {
                                         printLine(MESSAGE_LINE, "Nothing in that slot.");
                                         break;
                                     }
-                                    std::string itemName = item->getName();
+                                    const std::string& itemName = item->getName();
                                     player.dropFromInventory(index);
                                     printLine(MESSAGE_LINE, "%s has been dropped.", itemName.c_str());
                                 }
@@ -370,7 +396,7 @@ int playGame() {
                                 int replaceFogOfWar = fogOfWarToggle;
                                 fogOfWarToggle = false;
                                 printDungeon();
-                                refresh();
+                                renderer->present();
 
                                 bool drop = false;
                                 int x = player.getPos().x;
@@ -378,16 +404,20 @@ int playGame() {
                                 while (!drop) {
                                     int oldX = x;
                                     int oldY = y;
-                                    mvaddch(y + 1, x, '*');
-                                    refresh();
+                                    // The cursor may wander off screen on a large map
+                                    if (scrollViewport((Pos){x, y})) {
+                                        drawDungeon();
+                                    }
+                                    renderer->drawMapChar(y, x, '*', Color::Default);
+                                    renderer->present();
                             
                                     int ch;
                                     ch = getch();
                                     printLine(MESSAGE_LINE, "Use movement keys to move and 'g' to finalize, or 'r' to be placed randomly.");
                                     switch (ch) {
                                         case 'r':
-                                            x = rand() % (MAX_WIDTH - 2) + 1;
-                                            y = rand() % (MAX_HEIGHT - 2) + 1;
+                                            x = rand() % (dungeonWidth - 2) + 1;
+                                            y = rand() % (dungeonHeight - 2) + 1;
                                             drop = true;
                                             break;
                             
@@ -424,7 +454,7 @@ int playGame() {
                                         case '9':
                                         case 'u':
                                             x += 1;
-                                            if (x == MAX_WIDTH - 1) {
+                                            if (x == dungeonWidth - 1) {
                                                 x--;
                                                 printLine(MESSAGE_LINE, "That's an impenetrable wall.");
                                             } 
@@ -439,7 +469,7 @@ int playGame() {
                                         case '6':
                                         case 'l':
                                             x += 1;
-                                            if (x == MAX_WIDTH - 1) {
+                                            if (x == dungeonWidth - 1) {
                                                 x--;
                                                 printLine(MESSAGE_LINE, "That's an impenetrable wall.");
                                             }
@@ -449,12 +479,12 @@ int playGame() {
                                         case '3':
                                         case 'n':
                                             x += 1;
-                                            if (x == MAX_WIDTH - 1) {
+                                            if (x == dungeonWidth - 1) {
                                                 x--;
                                                 printLine(MESSAGE_LINE, "That's an impenetrable wall.");
                                             }
                                             y += 1;
-                                            if (y == MAX_HEIGHT - 1) {
+                                            if (y == dungeonHeight - 1) {
                                                 y--;
                                                 printLine(MESSAGE_LINE, "That's an impenetrable wall.");
                                             }
@@ -464,7 +494,7 @@ int playGame() {
                                         case '2':
                                         case 'j':
                                             y += 1;
-                                            if (y == MAX_HEIGHT - 1) {
+                                            if (y == dungeonHeight - 1) {
                                                 y--;
                                                 printLine(MESSAGE_LINE, "That's an impenetrable wall.");
                                             }
@@ -479,7 +509,7 @@ int playGame() {
                                                 printLine(MESSAGE_LINE, "That's an impenetrable wall.");
                                             }
                                             y += 1;
-                                            if (y == MAX_HEIGHT - 1) {
+                                            if (y == dungeonHeight - 1) {
                                                 y--;
                                                 printLine(MESSAGE_LINE, "That's an impenetrable wall.");
                                             }
@@ -499,43 +529,37 @@ int playGame() {
                                             break;
                                     }
                                     if (player.getPos().x == oldX && player.getPos().y == oldY) {
-                                        mvaddch(oldY + 1, oldX, '@');
+                                        renderer->drawMapChar(oldY, oldX, '@', Color::Default);
                                     }
                                     else if (monsterAt[oldY][oldX]) {
                                         if (supportsColor) {
-                                            Color c = monsterAt[oldY][oldX].get()->getColor();
-                                            attron(COLOR_PAIR(c));
-                                            mvaddch(oldY + 1, oldX, monsterAt[oldY][oldX].get()->getSymbol());
-                                            attroff(COLOR_PAIR(c));
+                                            Color c = monsterAt[oldY][oldX]->getColor();
+                                            renderer->drawMapChar(oldY, oldX, monsterAt[oldY][oldX]->getSymbol(), c);
                                         }
                                         else {
-                                            mvaddch(oldY + 1, oldX, monsterAt[oldY][oldX].get()->getSymbol());
+                                            renderer->drawMapChar(oldY, oldX, monsterAt[oldY][oldX]->getSymbol(), Color::Default);
                                         }
                                     }
                                     else if (objectsAt[oldY][oldX].size() > 0) {
                                         if (supportsColor) {
                                             Color c = objectsAt[oldY][oldX].back()->getColor();
-                                            attron(COLOR_PAIR(c));
-                                            mvaddch(oldY + 1, oldX, objectsAt[oldY][oldX].back()->getSymbol());
-                                            attroff(COLOR_PAIR(c));
+                                            renderer->drawMapChar(oldY, oldX, objectsAt[oldY][oldX].back()->getSymbol(), c);
                                         }
                                         else {
-                                            mvaddch(oldY + 1, oldX, objectsAt[oldY][oldX].back()->getSymbol());
+                                            renderer->drawMapChar(oldY, oldX, objectsAt[oldY][oldX].back()->getSymbol(), Color::Default);
                                         }
                                     }
                                     else {
                                         if (inLineOfSight((Pos){oldX, oldY})) {
                                             if (supportsColor) {
-                                                attron(COLOR_PAIR(Color::Yellow));
-                                                mvaddch(oldY + 1, oldX, dungeon[oldY][oldX].visible);
-                                                attroff(COLOR_PAIR(Color::Yellow));
+                                                renderer->drawMapChar(oldY, oldX, dungeon[oldY][oldX].visible, Color::Yellow);
                                             }
                                             else {
-                                                mvaddch(oldY + 1, oldX, dungeon[oldY][oldX].visible);
+                                                renderer->drawMapChar(oldY, oldX, dungeon[oldY][oldX].visible, Color::Default);
                                             }
                                         }
                                         else {
-                                            mvaddch(oldY + 1, oldX, dungeon[oldY][oldX].type);
+                                            renderer->drawMapChar(oldY, oldX, dungeon[oldY][oldX].type, Color::Default);
                                         }
                                     }
                                 }
@@ -543,13 +567,14 @@ int playGame() {
                                 if (dungeon[y][x].type == ROCK) {
                                     dungeon[y][x].hardness = 0;
                                     dungeon[y][x].type = CORRIDOR;
+                                    terrainVersion++;
                                 }
 
                                 player.setPos((Pos){x, y});
-                                mvaddch(y + 1, x, '@');
+                                renderer->drawMapChar(y, x, '@', Color::Default);
 
                                 if (monsterAt[player.getPos().y][player.getPos().x]) {
-                                    Monster *mon = monsterAt[player.getPos().y][player.getPos().x].get();
+                                    Monster *mon = monsterAt[player.getPos().y][player.getPos().x];
                                     if (mon->isBoss()) {
                                         printDungeon();
                                         printLineColor(STATUS_LINE1, Color::Green, "%s has been slain!\n", mon->getName().c_str());
@@ -562,7 +587,8 @@ int playGame() {
                                     }
 
                                     printLineColor(STATUS_LINE1, Color::Green, "Player stomped %s", mon->getName().c_str());
-                                    monsterAt[player.getPos().y][player.getPos().x] = nullptr;
+                                    untrackMonster(mon);
+                                    removeMonster(mon);
                                 }
                                 else {
                                     printLine(STATUS_LINE1, "");
@@ -570,7 +596,7 @@ int playGame() {
                                 fogOfWarToggle = replaceFogOfWar;
                                 updateAroundPlayer();
                                 printDungeon();
-                                refresh();
+                                renderer->present();
                             }
                             break;
                         
@@ -601,7 +627,7 @@ int playGame() {
                                         printLine(MESSAGE_LINE, "Nothing in that slot.");
                                         break;
                                     }
-                                    std::string itemName = player.getEquipmentItem((Equip)index)->getName();
+                                    const std::string& itemName = player.getEquipmentItem((Equip)index)->getName();
                                     if (player.unequip((Equip)index)) {
                                         printLine(MESSAGE_LINE, "%s has been unequipped.", itemName.c_str());
                                     }
@@ -637,7 +663,7 @@ int playGame() {
                                         printLine(MESSAGE_LINE, "Nothing in that slot.");
                                         break;
                                     }
-                                    std::string itemName = item->getName();
+                                    const std::string& itemName = item->getName();
                                     if (item->getEquipmentIndex() == Equip::None) {
                                         printLine(MESSAGE_LINE, "%s is not an equipment item.", itemName.c_str());
                                         break;
@@ -732,7 +758,7 @@ int playGame() {
                                         printLine(MESSAGE_LINE, "Nothing in that slot.");
                                         break;
                                     }
-                                    std::string itemName = item->getName();
+                                    const std::string& itemName = item->getName();
                                     player.expungeFromInventory(index);
                                     printLine(MESSAGE_LINE, "%s has been obliterated.", itemName.c_str());
                                 }
@@ -745,17 +771,24 @@ int playGame() {
                             }
                             break;
 
+                        case 'C':
+                            toggleOverlay(Overlay::Corridors);
+                            break;
+
                         case 'D':
-                            nonTunnelingDistMap();
+                            toggleOverlay(Overlay::NonTunneling);
                             break;
                         
                         case 'E':
                             showEquipmentObjectDescription();
                             break;
 
+                        case 'F':
+                            toggleOverlay(Overlay::Fov);
+                            break;
+
                         case 'H':
-                            // "display the hardness map"
-                            printLine(MESSAGE_LINE, "Action for %c Not implemented yet!", (char) ch);
+                            toggleOverlay(Overlay::Hardness);
                             break;
 
                         case 'I':
@@ -771,8 +804,12 @@ int playGame() {
                                 while (!view) {
                                     int oldX = x;
                                     int oldY = y;
-                                    mvaddch(y + 1, x, '!');
-                                    refresh();
+                                    // The cursor may wander off screen on a large map
+                                    if (scrollViewport((Pos){x, y})) {
+                                        drawDungeon();
+                                    }
+                                    renderer->drawMapChar(y, x, '!', Color::Default);
+                                    renderer->present();
 
                                     int ch;
                                     ch = getch();
@@ -844,7 +881,7 @@ int playGame() {
                                                 x--;
                                                 printLine(MESSAGE_LINE, "You cannot see that far.");
                                             } 
-                                            else if (x == MAX_WIDTH - 1) {
+                                            else if (x == dungeonWidth - 1) {
                                                 x--;
                                                 printLine(MESSAGE_LINE, "That's an impenetrable wall.");
                                             }
@@ -872,7 +909,7 @@ int playGame() {
                                                 x--;
                                                 printLine(MESSAGE_LINE, "You cannot see that far.");
                                             }
-                                            else if (x == MAX_WIDTH - 1) {
+                                            else if (x == dungeonWidth - 1) {
                                                 x--;
                                                 printLine(MESSAGE_LINE, "That's an impenetrable wall.");
                                             }
@@ -890,7 +927,7 @@ int playGame() {
                                                 x--;
                                                 printLine(MESSAGE_LINE, "You cannot see that far.");
                                             }
-                                            else if (x == MAX_WIDTH - 1) {
+                                            else if (x == dungeonWidth - 1) {
                                                 x--;
                                                 printLine(MESSAGE_LINE, "That's an impenetrable wall.");
                                             }
@@ -899,7 +936,7 @@ int playGame() {
                                                 y--;
                                                 printLine(MESSAGE_LINE, "You cannot see that far.");
                                             }
-                                            else if (y == MAX_HEIGHT - 1) {
+                                            else if (y == dungeonHeight - 1) {
                                                 y--;
                                                 printLine(MESSAGE_LINE, "That's an impenetrable wall.");
                                             }
@@ -918,7 +955,7 @@ int playGame() {
                                                 y--;
                                                 printLine(MESSAGE_LINE, "You cannot see that far.");
                                             }
-                                            else if (y == MAX_HEIGHT - 1) {
+                                            else if (y == dungeonHeight - 1) {
                                                 y--;
                                                 printLine(MESSAGE_LINE, "That's an impenetrable wall.");
                                             }
@@ -945,7 +982,7 @@ int playGame() {
                                                 y--;
                                                 printLine(MESSAGE_LINE, "You cannot see that far.");
                                             }
-                                            else if (y == MAX_HEIGHT - 1) {
+                                            else if (y == dungeonHeight - 1) {
                                                 y--;
                                                 printLine(MESSAGE_LINE, "That's an impenetrable wall.");
                                             }
@@ -983,43 +1020,37 @@ int playGame() {
                                             break;
                                     }
                                     if (player.getPos().x == oldX && player.getPos().y == oldY) {
-                                        mvaddch(oldY + 1, oldX, '@');
+                                        renderer->drawMapChar(oldY, oldX, '@', Color::Default);
                                     }
                                     else if (monsterAt[oldY][oldX]) {
                                         if (supportsColor) {
-                                            Color c = monsterAt[oldY][oldX].get()->getColor();
-                                            attron(COLOR_PAIR(c));
-                                            mvaddch(oldY + 1, oldX, monsterAt[oldY][oldX].get()->getSymbol());
-                                            attroff(COLOR_PAIR(c));
+                                            Color c = monsterAt[oldY][oldX]->getColor();
+                                            renderer->drawMapChar(oldY, oldX, monsterAt[oldY][oldX]->getSymbol(), c);
                                         }
                                         else {
-                                            mvaddch(oldY + 1, oldX, monsterAt[oldY][oldX].get()->getSymbol());
+                                            renderer->drawMapChar(oldY, oldX, monsterAt[oldY][oldX]->getSymbol(), Color::Default);
                                         }
                                     }
                                     else if (objectsAt[oldY][oldX].size() > 0) {
                                         if (supportsColor) {
                                             Color c = objectsAt[oldY][oldX].back()->getColor();
-                                            attron(COLOR_PAIR(c));
-                                            mvaddch(oldY + 1, oldX, objectsAt[oldY][oldX].back()->getSymbol());
-                                            attroff(COLOR_PAIR(c));
+                                            renderer->drawMapChar(oldY, oldX, objectsAt[oldY][oldX].back()->getSymbol(), c);
                                         }
                                         else {
-                                            mvaddch(oldY + 1, oldX, objectsAt[oldY][oldX].back()->getSymbol());
+                                            renderer->drawMapChar(oldY, oldX, objectsAt[oldY][oldX].back()->getSymbol(), Color::Default);
                                         }
                                     }
                                     else {
                                         if (inLineOfSight((Pos){oldX, oldY})) {
                                             if (supportsColor) {
-                                                attron(COLOR_PAIR(Color::Yellow));
-                                                mvaddch(oldY + 1, oldX, dungeon[oldY][oldX].visible);
-                                                attroff(COLOR_PAIR(Color::Yellow));
+                                                renderer->drawMapChar(oldY, oldX, dungeon[oldY][oldX].visible, Color::Yellow);
                                             }
                                             else {
-                                                mvaddch(oldY + 1, oldX, dungeon[oldY][oldX].visible);
+                                                renderer->drawMapChar(oldY, oldX, dungeon[oldY][oldX].visible, Color::Default);
                                             }
                                         }
                                         else {
-                                            mvaddch(oldY + 1, oldX, dungeon[oldY][oldX].type);
+                                            renderer->drawMapChar(oldY, oldX, dungeon[oldY][oldX].type, Color::Default);
                                         }
                                     }
 
@@ -1029,7 +1060,7 @@ int playGame() {
                                 }
                                 if (escape) {
                                     printDungeon();
-                                    refresh();
+                                    renderer->present();
                                     break;
                                 }
                                 showMonsterInfo((Pos){x, y});
@@ -1043,8 +1074,16 @@ int playGame() {
                             clearAll();
                             return 0;
 
+                        case 'R':
+                            toggleOverlay(Overlay::Rooms);
+                            break;
+
+                        case 'S':
+                            toggleStatsOverlay();
+                            break;
+
                         case 'T':
-                            tunnelingDistMap();
+                            toggleOverlay(Overlay::Tunneling);
                             break;
 
                         case 'U':
@@ -1059,8 +1098,8 @@ int playGame() {
                                         printLine(MESSAGE_LINE, "Nothing in that slot.");
                                         break;
                                     }
-                                    std::string itemName = item->getName();
-                                    if (item->getTypes().front() == "FLASK") {
+                                    const std::string& itemName = item->getName();
+                                    if (item->getKind() == ObjectKind::Flask) {
                                         int amountHealed = player.heal(item->getSpecialAttribute());
                                         int hp = player.getHitpoints();
                                         player.expungeFromInventory(index);
@@ -1104,7 +1143,7 @@ int playGame() {
 
                         case ',':
                             if (!objectsAt[player.getPos().y][player.getPos().x].empty()) {
-                                std::string itemName = objectsAt[player.getPos().y][player.getPos().x].back()->getName();
+                                const std::string& itemName = objectsAt[player.getPos().y][player.getPos().x].back()->getName();
                                 bool added = player.addToInventory(player.getPos());
                                 if (added) {
                                     printLine(MESSAGE_LINE, "Picked up %s.", itemName.c_str()); 
@@ -1134,7 +1173,7 @@ int playGame() {
                 }
                 else if (dungeon[player.getPos().y + yDir][player.getPos().x + xDir].hardness == 0) {
                     if (monsterAt[player.getPos().y + yDir][player.getPos().x + xDir]) {
-                        Monster *mon = monsterAt[player.getPos().y + yDir][player.getPos().x + xDir].get();
+                        Monster *mon = monsterAt[player.getPos().y + yDir][player.getPos().x + xDir];
 
                         if (player.attemptHit(mon->getDodgeBonus())) {
                             int dam = player.doDamage();
@@ -1154,17 +1193,16 @@ int playGame() {
                                 }
 
                                 printLineColor(STATUS_LINE1, Color::Green, "%s has been slain.\n", mon->getName().c_str());
-                                monsterAt[mon->getPos().y][mon->getPos().x] = nullptr;
+                                untrackMonster(mon);
+                                removeMonster(mon);
                             }
                             else {
                                 if (supportsColor) {
-                                    attron(COLOR_PAIR(Color::Red));
-                                    mvaddch(mon->getPos().y + 1, mon->getPos().x, mon->getSymbol());
-                                    attroff(COLOR_PAIR(Color::Red));
+                                    renderer->drawMapChar(mon->getPos().y, mon->getPos().x, mon->getSymbol(), Color::Red);
                                 }
 
                                 std::string action = "You dealt " + std::to_string(damageTaken) + " damage to " + mon->getName() + ".";
-                                fitString(action, MAX_WIDTH);
+                                fitString(action, VIEW_WIDTH);
                                 actions.push_back(std::make_pair(action, Color::Green));
 
                                 printLineColor(STATUS_LINE1, Color::Green, "%s", action.c_str());
@@ -1176,13 +1214,11 @@ int playGame() {
                         }
                         else {
                             if (supportsColor) {
-                                attron(COLOR_PAIR(Color::Yellow));
-                                mvaddch(mon->getPos().y + 1, mon->getPos().x, mon->getSymbol());
-                                attroff(COLOR_PAIR(Color::Yellow));
+                                renderer->drawMapChar(mon->getPos().y, mon->getPos().x, mon->getSymbol(), Color::Yellow);
                             }
 
                             std::string action = "You missed " + mon->getName() + ".";
-                            fitString(action, MAX_WIDTH);
+                            fitString(action, VIEW_WIDTH);
                             actions.push_back(std::make_pair(action, Color::Yellow));
 
                             printLineColor(STATUS_LINE1, Color::Yellow, "%s", action.c_str());
@@ -1210,12 +1246,17 @@ int playGame() {
                 }
             }
             actions.clear();
+            if (playerTurnLatency() != nullptr) {
+                playerTurnLatency()->record(monotonicNanos() - keyNanos);
+            }
         }
         else {
-            Monster *mon = monsterAt[node->getPos().y][node->getPos().x].get();
+            PhaseProbe probe(Phase::MonsterAI);
+            Monster *mon = monsterAt[node->getPos().y][node->getPos().x];
             if (mon == nullptr) {
                 continue;
             }
+            LatencyTimer turnTimer(monsterTurnLatency(mon->getMonTypeIndex()));
             int x = mon->getPos().x;
             int y = mon->getPos().y;
 
@@ -1234,8 +1275,11 @@ int playGame() {
                 }
             }
 
-            bool visited[MAX_HEIGHT][MAX_WIDTH] = {{false}};
-            int sameCorridor = checkCorridor(x, y, visited);
+            int sameCorridor;
+            {
+                PhaseProbe probe(Phase::CheckCorridor);
+                sameCorridor = checkCorridor(x, y);
+            }
 
             bool hasLastSeen = (mon->getLastSeen().x != -1 && mon->getLastSeen().y != -1);
             bool canSee = (mon->isTelepathic() || sameRoom || sameCorridor);
@@ -1251,37 +1295,29 @@ int playGame() {
                     newX = x + directions[dir][0];
                     newY = y + directions[dir][1];
                     
-                    if ((mon->isTunneling() && dungeon[newY][newX].tunnelingDist != UNREACHABLE) ||
-                       (!mon->isTunneling() && dungeon[newY][newX].nonTunnelingDist != UNREACHABLE)) {
+                    if (lastField == nullptr || lastField->forMonster(mon)[newY][newX] != UNREACHABLE) {
                         break;
                     }
                 }
             }
             else if (canSee || hasLastSeen) {
-                if (canSee) {
-                    generateDistances(player.getPos());
-                }
-                else {
-                    generateDistances(mon->getLastSeen());
-                }
+                lastField = &generateDistances(canSee ? player.getPos() : mon->getLastSeen());
+                const Grid<int>& dist = lastField->forMonster(mon);
                 
                 if (mon->isIntelligent()) {
-                    if (!((mon->isTunneling() && dungeon[y][x].tunnelingDist == 0) ||
-                        (!mon->isTunneling() && dungeon[y][x].nonTunnelingDist == 0))) {
+                    if (dist[y][x] != 0) {
                         int minDist = UNREACHABLE;
                         int possibleDir[8] = {0};
                         int numPossible = 0;
                         for (int i = 0; i < 8; i++) {
                             int possibleX = x + directions[i][0];
                             int possibleY = y + directions[i][1];
-                            if ((mon->isTunneling() && dungeon[possibleY][possibleX].tunnelingDist < minDist) ||
-                            (!mon->isTunneling() && dungeon[possibleY][possibleX].nonTunnelingDist < minDist)) {
+                            if (dist[possibleY][possibleX] < minDist) {
                                 numPossible = 1;
-                                minDist = mon->isTunneling() ? dungeon[possibleY][possibleX].tunnelingDist : dungeon[possibleY][possibleX].nonTunnelingDist;
+                                minDist = dist[possibleY][possibleX];
                                 possibleDir[0] = i;
                             }
-                            else if ((mon->isTunneling() && dungeon[newY][newX].tunnelingDist == minDist) ||
-                                    (!mon->isTunneling() && dungeon[newY][newX].nonTunnelingDist == minDist)) {
+                            else if (dist[newY][newX] == minDist) {
                                 numPossible++;
                                 possibleDir[numPossible - 1] = i;
                             }
@@ -1328,8 +1364,7 @@ int playGame() {
     
                     newX = x + xDir;
                     newY = y + yDir;
-                    if ((mon->isTunneling() && dungeon[newY][newX].tunnelingDist == UNREACHABLE) ||
-                        (!mon->isTunneling() && dungeon[newY][newX].nonTunnelingDist == UNREACHABLE)) {
+                    if (dist[newY][newX] == UNREACHABLE) {
 
                         node->setKey(time + 1000 / mon->getSpeed());
                         heap.get()->insertNode(node);
@@ -1346,6 +1381,7 @@ int playGame() {
             else if (dungeon[newY][newX].type == ROCK) {
                 if (dungeon[newY][newX].hardness > 85) {
                     dungeon[newY][newX].hardness -= 85;
+                    terrainVersion++;
 
                     node->setKey(time + 1000 / mon->getSpeed());
                     heap.get()->insertNode(node);
@@ -1353,9 +1389,9 @@ int playGame() {
                 else {
                     dungeon[newY][newX].hardness = 0;
                     dungeon[newY][newX].type = CORRIDOR;
+                    terrainVersion++;
 
-                    mon->setPos((Pos){newX, newY});
-                    monsterAt[newY][newX] = std::move(monsterAt[y][x]);
+                    moveMonster(mon, (Pos){newX, newY});
 
                     node->setKey(time + 1000 / mon->getSpeed());
                     node->setPos((Pos){newX, newY});
@@ -1364,7 +1400,7 @@ int playGame() {
             }
             else {
                 if (monsterAt[newY][newX]) {
-                    Monster* monDisplace = monsterAt[newY][newX].get();
+                    Monster* monDisplace = monsterAt[newY][newX];
                     int possibleDir[8] = {0};
                     int numPossible = 0;
                     for (int i = 0; i < 8; i++) {
@@ -1383,11 +1419,8 @@ int playGame() {
                         int displaceX = newX + directions[dir][0];
                         int displaceY = newY + directions[dir][1];
 
-                        monDisplace->setPos((Pos){displaceX, displaceY});
-                        mon->setPos((Pos){newX, newY});
-
-                        monsterAt[displaceY][displaceX] = std::move(monsterAt[newY][newX]);
-                        monsterAt[newY][newX] = std::move(monsterAt[y][x]);
+                        moveMonster(monDisplace, (Pos){displaceX, displaceY});
+                        moveMonster(mon, (Pos){newX, newY});
 
                         node->setKey(time + 1000 / mon->getSpeed());
                         node->setPos((Pos){newX, newY});
@@ -1397,12 +1430,7 @@ int playGame() {
                         displaceNode->setPos((Pos){displaceX, displaceY});
                     }
                     else {
-                        monDisplace->setPos((Pos){x, y});
-                        mon->setPos((Pos){newX, newY});
-
-                        std::unique_ptr<Monster> tmp = std::move(monsterAt[y][x]);
-                        monsterAt[y][x] = std::move(monsterAt[newY][newX]);
-                        monsterAt[newY][newX] = std::move(tmp);
+                        swapMonsters(mon, monDisplace);
 
                         node->setKey(time + 1000 / mon->getSpeed());
                         node->setPos((Pos){newX, newY});
@@ -1418,22 +1446,18 @@ int playGame() {
                         printDungeon();
 
                         if (supportsColor) {
-                            attron(COLOR_PAIR(Color::Yellow));
-                            mvaddch(player.getPos().y + 1, player.getPos().x, '@');
-                            attroff(COLOR_PAIR(Color::Yellow));
+                            renderer->drawMapChar(player.getPos().y, player.getPos().x, '@', Color::Yellow);
                         }
 
                         std::string action = mon->getName() + " fails to realize they are in the presence of a god.";
-                        fitString(action, MAX_WIDTH);
+                        fitString(action, VIEW_WIDTH);
                         actions.push_back(std::make_pair(action, Color::Yellow));
 
                         printLineColor(STATUS_LINE1, Color::Yellow, "%s", action.c_str());
                         napms(400);
                         flushinp(); 
                         if (supportsColor) {
-                            attron(COLOR_PAIR(Color::White));
-                            mvaddch(player.getPos().y + 1, player.getPos().x, '@');
-                            attroff(COLOR_PAIR(Color::White));
+                            renderer->drawMapChar(player.getPos().y, player.getPos().x, '@', Color::White);
                         }                  
                         printLine(STATUS_LINE1, "%s", action.c_str());
                         napms(100);
@@ -1461,44 +1485,36 @@ int playGame() {
 
                             if (dam > 0) {
                                 if (supportsColor) {
-                                    attron(COLOR_PAIR(Color::Red));
-                                    mvaddch(player.getPos().y + 1, player.getPos().x, '@');
-                                    attroff(COLOR_PAIR(Color::Red));
+                                    renderer->drawMapChar(player.getPos().y, player.getPos().x, '@', Color::Red);
                                 }
 
                                 std::string action = mon->getName() + " dealt " + std::to_string(damageTaken) + " damage to you.";
-                                fitString(action, MAX_WIDTH);
+                                fitString(action, VIEW_WIDTH);
                                 actions.push_back(std::make_pair(action, Color::Red));
 
                                 printLineColor(STATUS_LINE1, Color::Red, "%s", action.c_str());
                                 napms(400);
                                 flushinp();
                                 if (supportsColor) {
-                                    attron(COLOR_PAIR(Color::White));
-                                    mvaddch(player.getPos().y + 1, player.getPos().x, '@');
-                                    attroff(COLOR_PAIR(Color::White));
+                                    renderer->drawMapChar(player.getPos().y, player.getPos().x, '@', Color::White);
                                 }           
                                 printLine(STATUS_LINE1, "%s", action.c_str());
                                 napms(100);
                             }
                             else {
                                 if (supportsColor) {
-                                    attron(COLOR_PAIR(Color::Yellow));
-                                    mvaddch(player.getPos().y + 1, player.getPos().x, '@');
-                                    attroff(COLOR_PAIR(Color::Yellow));
+                                    renderer->drawMapChar(player.getPos().y, player.getPos().x, '@', Color::Yellow);
                                 }
 
                                 std::string action = mon->getName() + " did nothing to you.";
-                                fitString(action, MAX_WIDTH);
+                                fitString(action, VIEW_WIDTH);
                                 actions.push_back(std::make_pair(action, Color::Yellow));
 
                                 printLineColor(STATUS_LINE1, Color::Yellow, "%s", action.c_str());
                                 napms(400);
                                 flushinp();
                                 if (supportsColor) {
-                                    attron(COLOR_PAIR(Color::White));
-                                    mvaddch(player.getPos().y + 1, player.getPos().x, '@');
-                                    attroff(COLOR_PAIR(Color::White));
+                                    renderer->drawMapChar(player.getPos().y, player.getPos().x, '@', Color::White);
                                 }           
                                 printLine(STATUS_LINE1, "%s", action.c_str());
                                 napms(100);
@@ -1510,22 +1526,18 @@ int playGame() {
                         printDungeon();
 
                         if (supportsColor) {
-                            attron(COLOR_PAIR(Color::Yellow));
-                            mvaddch(player.getPos().y + 1, player.getPos().x, '@');
-                            attroff(COLOR_PAIR(Color::Yellow));
+                            renderer->drawMapChar(player.getPos().y, player.getPos().x, '@', Color::Yellow);
                         }
 
                         std::string action = "You dodged " + mon->getName() + "'s attack.";
-                        fitString(action, MAX_WIDTH);
+                        fitString(action, VIEW_WIDTH);
                         actions.push_back(std::make_pair(action, Color::Yellow));
 
                         printLineColor(STATUS_LINE1, Color::Yellow, "%s", action.c_str());
                         napms(400);
                         flushinp();
                         if (supportsColor) {
-                            attron(COLOR_PAIR(Color::White));
-                            mvaddch(player.getPos().y + 1, player.getPos().x, '@');
-                            attroff(COLOR_PAIR(Color::White));
+                            renderer->drawMapChar(player.getPos().y, player.getPos().x, '@', Color::White);
                         }           
                         printLine(STATUS_LINE1, "%s", action.c_str());
                         napms(100);
@@ -1535,9 +1547,7 @@ int playGame() {
                     heap.get()->insertNode(node);
                 }
                 else {
-                    mon->setPos((Pos){newX, newY});
-
-                    monsterAt[newY][newX] = std::move(monsterAt[y][x]);
+                    moveMonster(mon, (Pos){newX, newY});
 
                     node->setKey(time + 1000 / mon->getSpeed());
                     node->setPos((Pos){newX, newY});
@@ -0,0 +1,490 @@
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "dungeon.hpp"
+#include "game.hpp"
+#include "generator.hpp"
+#include "pathFinding.hpp"
+#include "perlin.hpp"
+#include "trace.hpp"
+
+static const int BSP_MIN_LEAF_WIDTH = 14;
+static const int BSP_MIN_LEAF_HEIGHT = 7;
+static const int CAVE_SMOOTHING_PASSES = 5;
+// A kept cave covers at least this fraction of the interior
+static const int CAVE_MIN_OPEN_DIVISOR = 4;
+static const int CAVE_MIN_ROOMS = 3;
+
+std::unique_ptr<Generator> generator = std::make_unique<RandomWalkGenerator>();
+
+void RandomWalkGenerator::generate() {
+    buildRooms();
+    buildCorridors();
+}
+
+// Returns the index of one room in the subtree so the caller can join it to its sibling, or -1
+int BspGenerator::split(int x, int y, int width, int height) {
+    bool canSplitWidth = width >= 2 * BSP_MIN_LEAF_WIDTH;
+    bool canSplitHeight = height >= 2 * BSP_MIN_LEAF_HEIGHT;
+    bool smallEnough = width < 3 * BSP_MIN_LEAF_WIDTH && height < 3 * BSP_MIN_LEAF_HEIGHT;
+
+    if ((!canSplitWidth && !canSplitHeight) || (smallEnough && rand() % 4 == 0)) {
+        if (width < 6 || height < 5) {
+            return -1;
+        }
+
+        // The leaf's edge is left as rock so rooms in neighboring leaves never touch
+        int roomWidth = rand() % (std::min(12, width - 2) - 3) + 4;
+        int roomHeight = rand() % (std::min(12, height - 2) - 2) + 3;
+        int roomX = x + 1 + rand() % (width - roomWidth - 1);
+        int roomY = y + 1 + rand() % (height - roomHeight - 1);
+
+        Room room = Room((Pos){roomX, roomY}, roomWidth, roomHeight);
+        if (!placeRoom(room)) {
+            return -1;
+        }
+        rooms.emplace_back(room);
+        return rooms.size() - 1;
+    }
+
+    // Cut across the longer side, a map cell is about twice as tall as it is wide
+    int first, second;
+    if (canSplitWidth && (!canSplitHeight || width > 2 * height)) {
+        int cut = rand() % (width - 2 * BSP_MIN_LEAF_WIDTH + 1) + BSP_MIN_LEAF_WIDTH;
+        first = split(x, y, cut, height);
+        second = split(x + cut, y, width - cut, height);
+    }
+    else {
+        int cut = rand() % (height - 2 * BSP_MIN_LEAF_HEIGHT + 1) + BSP_MIN_LEAF_HEIGHT;
+        first = split(x, y, width, cut);
+        second = split(x, y + cut, width, height - cut);
+    }
+
+    if (first == -1 || second == -1) {
+        return first == -1 ? second : first;
+    }
+    digCorridor(rooms[first], rooms[second]);
+    return rand() % 2 ? first : second;
+}
+
+void BspGenerator::generate() {
+    TraceSpan span("bsp", "generation");
+    split(1, 1, dungeonWidth - 2, dungeonHeight - 2);
+    roomCount = rooms.size();
+}
+
+void MstGenerator::generate() {
+    buildRooms();
+
+    TraceSpan span("mst corridors", "generation");
+    int n = rooms.size();
+    if (n == 0) {
+        return;
+    }
+    std::vector<bool> inTree(n, false);
+    std::vector<int> bestDist(n, INT_MAX);
+    std::vector<int> bestFrom(n, -1);
+
+    // Prim's on the dense graph of room centers, n is small enough that O(n^2) wins
+    bestDist[0] = 0;
+    for (int step = 0; step < n; step++) {
+        int next = -1;
+        for (int i = 0; i < n; i++) {
+            if (!inTree[i] && (next == -1 || bestDist[i] < bestDist[next])) {
+                next = i;
+            }
+        }
+        inTree[next] = true;
+        if (bestFrom[next] != -1) {
+            digCorridor(rooms[bestFrom[next]], rooms[next]);
+        }
+
+        int nextX = rooms[next].getPos().x * 2 + rooms[next].getWidth();
+        int nextY = rooms[next].getPos().y * 2 + rooms[next].getHeight();
+        for (int i = 0; i < n; i++) {
+            int dx = rooms[i].getPos().x * 2 + rooms[i].getWidth() - nextX;
+            int dy = rooms[i].getPos().y * 2 + rooms[i].getHeight() - nextY;
+            if (!inTree[i] && dx * dx + dy * dy < bestDist[i]) {
+                bestDist[i] = dx * dx + dy * dy;
+                bestFrom[i] = next;
+            }
+        }
+    }
+}
+
+static bool isRock(const uint64_t *row, int x) {
+    return (row[x / 64] >> (x % 64)) & 1;
+}
+
+static void setRock(uint64_t *row, int x) {
+    row[x / 64] |= 1ULL << (x % 64);
+}
+
+// Rock odds follow the hardness noise, so caves open up where the rock is soft
+void CaveGenerator::seed() {
+    words = (dungeonWidth + 63) / 64;
+    cells.resize(words, dungeonHeight);
+    for (int y = 0; y < dungeonHeight; y++) {
+        for (int x = 0; x < dungeonWidth; x++) {
+            bool border = y == 0 || y == dungeonHeight - 1 || x == 0 || x == dungeonWidth - 1;
+            if (border || rand() % 100 < 30 + dungeon[y][x].hardness * 30 / MAX_HARDNESS) {
+                setRock(cells[y], x);
+            }
+        }
+        if (dungeonWidth % 64 != 0) {
+            cells[y][words - 1] |= ~0ULL << (dungeonWidth % 64);
+        }
+    }
+}
+
+// One bit plane of a 4 bit counter per cell, adds a 0/1 plane to 64 counters at once
+static void addPlane(uint64_t count[4], uint64_t plane) {
+    for (int bit = 0; bit < 4 && plane != 0; bit++) {
+        uint64_t carry = count[bit] & plane;
+        count[bit] ^= plane;
+        plane = carry;
+    }
+}
+
+// The 4-5 rule: a cell is rock next pass when at least 5 cells of its 3x3 block are rock
+void CaveGenerator::smooth() {
+    Grid<uint64_t> next(words, dungeonHeight);
+    for (int y = 1; y < dungeonHeight - 1; y++) {
+        for (int w = 0; w < words; w++) {
+            uint64_t count[4] = {0, 0, 0, 0};
+            for (int dy = -1; dy <= 1; dy++) {
+                const uint64_t *row = cells[y + dy];
+                uint64_t west = (row[w] << 1) | (w > 0 ? row[w - 1] >> 63 : 1);
+                uint64_t east = (row[w] >> 1) | (w + 1 < words ? row[w + 1] << 63 : 1ULL << 63);
+                addPlane(count, west);
+                addPlane(count, row[w]);
+                addPlane(count, east);
+            }
+            next[y][w] = count[3] | (count[2] & (count[1] | count[0]));
+        }
+
+        setRock(next[y], 0);
+        setRock(next[y], dungeonWidth - 1);
+        if (dungeonWidth % 64 != 0) {
+            next[y][words - 1] |= ~0ULL << (dungeonWidth % 64);
+        }
+    }
+    memcpy(cells[1], next[1], sizeof(uint64_t) * words * (dungeonHeight - 2));
+}
+
+// Labels the open regions, fills in all but the largest and returns its size
+int CaveGenerator::keepLargestRegion() {
+    Grid<int> label(dungeonWidth, dungeonHeight);
+
+    std::vector<Pos> stack;
+    int regions = 0;
+    int largest = 0;
+    int largestSize = 0;
+    for (int y = 1; y < dungeonHeight - 1; y++) {
+        for (int x = 1; x < dungeonWidth - 1; x++) {
+            if (label[y][x] != 0 || isRock(cells[y], x)) {
+                continue;
+            }
+
+            regions++;
+            int size = 0;
+            label[y][x] = regions;
+            stack.push_back((Pos){x, y});
+            while (!stack.empty()) {
+                Pos pos = stack.back();
+                stack.pop_back();
+                size++;
+                for (int dy = -1; dy <= 1; dy++) {
+                    for (int dx = -1; dx <= 1; dx++) {
+                        int nx = pos.x + dx;
+                        int ny = pos.y + dy;
+                        if (label[ny][nx] == 0 && !isRock(cells[ny], nx)) {
+                            label[ny][nx] = regions;
+                            stack.push_back((Pos){nx, ny});
+                        }
+                    }
+                }
+            }
+
+            if (size > largestSize) {
+                largest = regions;
+                largestSize = size;
+            }
+        }
+    }
+
+    for (int y = 1; y < dungeonHeight - 1; y++) {
+        for (int x = 1; x < dungeonWidth - 1; x++) {
+            if (label[y][x] != 0 && label[y][x] != largest) {
+                setRock(cells[y], x);
+            }
+        }
+    }
+    return largestSize;
+}
+
+static bool overlapsRoom(int x, int y, int width, int height) {
+    for (Room& room : rooms) {
+        if (x < room.getPos().x + room.getWidth() && room.getPos().x < x + width &&
+            y < room.getPos().y + room.getHeight() && room.getPos().y < y + height) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Caves have no rooms, but spawning and stairs work from rooms, so mark open rectangles as rooms
+void CaveGenerator::claimRooms() {
+    buildFloorSums();
+
+    bool noFit[13][13] = {{false}};
+    std::vector<Pos> fits;
+    for (int i = 0; i < roomCount; i++) {
+        for (int j = 0; j < ATTEMPTS; j++) {
+            int width = rand() % 9 + 4;
+            int height = rand() % 6 + 3;
+            if (noFit[height][width]) {
+                continue;
+            }
+
+            // Random spots first, as buildRooms does, every open spot is listed only once they miss
+            Pos at = {-1, -1};
+            for (int k = 0; k < ROOM_SAMPLES && at.x == -1; k++) {
+                int x = rand() % (dungeonWidth - width - 1) + 1;
+                int y = rand() % (dungeonHeight - height - 1) + 1;
+                if (floorInRect(x, y, width, height) == width * height && !overlapsRoom(x, y, width, height)) {
+                    at = (Pos){x, y};
+                }
+            }
+
+            if (at.x == -1) {
+                fits.clear();
+                for (int y = 1; y < dungeonHeight - height; y++) {
+                    for (int x = 1; x < dungeonWidth - width; x++) {
+                        if (floorInRect(x, y, width, height) == width * height && !overlapsRoom(x, y, width, height)) {
+                            fits.push_back((Pos){x, y});
+                        }
+                    }
+                }
+                if (fits.empty()) {
+                    noFit[height][width] = true;
+                    continue;
+                }
+                at = fits[rand() % fits.size()];
+            }
+
+            rooms.emplace_back(at, width, height);
+            break;
+        }
+    }
+    roomCount = rooms.size();
+}
+
+void CaveGenerator::generate() {
+    TraceSpan span("cave", "generation");
+    for (int attempt = 0; attempt < ATTEMPTS; attempt++) {
+        seed();
+        for (int i = 0; i < CAVE_SMOOTHING_PASSES; i++) {
+            smooth();
+        }
+        if (keepLargestRegion() < (dungeonWidth - 2) * (dungeonHeight - 2) / CAVE_MIN_OPEN_DIVISOR) {
+            continue;
+        }
+
+        // Types first so the rooms can be found, the hardness is only cleared once the cave is kept
+        for (int y = 0; y < dungeonHeight; y++) {
+            for (int x = 0; x < dungeonWidth; x++) {
+                dungeon[y][x].type = isRock(cells[y], x) ? ROCK : FLOOR;
+            }
+        }
+        claimRooms();
+        if (static_cast<int>(rooms.size()) >= CAVE_MIN_ROOMS) {
+            for (int y = 0; y < dungeonHeight; y++) {
+                for (int x = 0; x < dungeonWidth; x++) {
+                    if (dungeon[y][x].type == FLOOR) {
+                        dungeon[y][x].hardness = 0;
+                    }
+                }
+            }
+            return;
+        }
+
+        rooms.clear();
+        for (int y = 0; y < dungeonHeight; y++) {
+            for (int x = 0; x < dungeonWidth; x++) {
+                dungeon[y][x].type = ROCK;
+            }
+        }
+    }
+
+    // Never seen in practice, but a level must come out of this no matter what
+    buildFloorSums();
+    RandomWalkGenerator().generate();
+}
+
+std::unique_ptr<Generator> makeGenerator(const char *name) {
+    if (!strcmp(name, "rooms")) {
+        return std::make_unique<RandomWalkGenerator>();
+    }
+    else if (!strcmp(name, "bsp")) {
+        return std::make_unique<BspGenerator>();
+    }
+    else if (!strcmp(name, "mst")) {
+        return std::make_unique<MstGenerator>();
+    }
+    else if (!strcmp(name, "cave")) {
+        return std::make_unique<CaveGenerator>();
+    }
+    return nullptr;
+}
+
+int reachableCells() {
+    Grid<char> seen(dungeonWidth, dungeonHeight);
+
+    std::vector<Pos> stack;
+    stack.push_back(upStairs.back());
+    seen[upStairs.back().y][upStairs.back().x] = true;
+    int count = 0;
+    while (!stack.empty()) {
+        Pos pos = stack.back();
+        stack.pop_back();
+        count++;
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                int x = pos.x + dx;
+                int y = pos.y + dy;
+                if (x >= 0 && x < dungeonWidth && y >= 0 && y < dungeonHeight && !seen[y][x] && dungeon[y][x].type != ROCK) {
+                    seen[y][x] = true;
+                    stack.push_back((Pos){x, y});
+                }
+            }
+        }
+    }
+    return count;
+}
+
+// splitmix32 finalizer, neighboring levels get unrelated seeds
+unsigned int levelSeed(unsigned int seed, int level) {
+    uint32_t z = seed + 0x9e3779b9u * (static_cast<uint32_t>(level) + 1);
+    z = (z ^ (z >> 16)) * 0x85ebca6bu;
+    z = (z ^ (z >> 13)) * 0xc2b2ae35u;
+    return z ^ (z >> 16);
+}
+
+int generatorBenchmark(int levels) {
+    static const char *names[] = {"rooms", "bsp", "mst", "cave"};
+    std::unique_ptr<Generator> selected = std::move(generator);
+
+    printf("Generating %d levels per engine\n", levels);
+    printf("%-8s  %12s  %8s  %8s  %10s  %10s\n", "engine", "levels/s", "rooms", "fill %", "corridors", "connected");
+
+    for (const char *name : names) {
+        generator = makeGenerator(name);
+        srand(levels);
+
+        long roomTotal = 0;
+        long openTotal = 0;
+        long corridorTotal = 0;
+        int connected = 0;
+        double seconds = 0;
+        for (int i = 0; i < levels; i++) {
+            clearAll();
+            auto begin = std::chrono::steady_clock::now();
+            initDungeon();
+            generateStructures();
+            seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+            int open = 0;
+            for (int y = 0; y < dungeonHeight; y++) {
+                for (int x = 0; x < dungeonWidth; x++) {
+                    open += dungeon[y][x].type != ROCK;
+                    corridorTotal += dungeon[y][x].type == CORRIDOR;
+                }
+            }
+            roomTotal += rooms.size();
+            openTotal += open;
+            connected += reachableCells() == open;
+        }
+
+        double interior = static_cast<double>(dungeonWidth - 2) * (dungeonHeight - 2) * levels;
+        printf("%-8s  %12.0f  %8.2f  %8.1f  %10.1f  %9.1f%%\n", name, levels / seconds,
+               static_cast<double>(roomTotal) / levels, 100.0 * openTotal / interior,
+               static_cast<double>(corridorTotal) / levels, 100.0 * connected / levels);
+    }
+
+    clearAll();
+    generator = std::move(selected);
+    return 0;
+}
+
+int scaleBenchmark(int levels) {
+    static const char *stages[] = {"clear", "hardness", "structures", "spawning", "distances", "fov"};
+    static const int STAGES = sizeof(stages) / sizeof(stages[0]);
+    double seconds[STAGES] = {0};
+
+    printf("Timing %d %s levels at %dx%d\n", levels, generator->getName(), dungeonWidth, dungeonHeight);
+    srand(levels);
+    for (int i = 0; i < levels; i++) {
+        auto begin = std::chrono::steady_clock::now();
+        auto lap = [&](int stage) {
+            auto now = std::chrono::steady_clock::now();
+            seconds[stage] += std::chrono::duration<double>(now - begin).count();
+            begin = now;
+        };
+
+        // The previous level's entities go here
+        clearAll();
+        lap(0);
+        initDungeon();
+        lap(1);
+        generateStructures();
+        lap(2);
+        spawnPlayer();
+        spawnMonsters(numMonsters, player.getPos().x, player.getPos().y);
+        spawnObjects(numObjects);
+        lap(3);
+        distancesFrom(player.getPos());
+        lap(4);
+        updateAroundPlayer();
+        lap(5);
+    }
+
+    printf("%-12s  %12s\n", "stage", "ms/level");
+    for (int stage = 0; stage < STAGES; stage++) {
+        printf("%-12s  %12.3f\n", stages[stage], 1000.0 * seconds[stage] / levels);
+    }
+    clearAll();
+
+    // The same fields through each noise kernel, which must agree with the first
+    std::string selected = noisePath();
+    std::vector<int> reference;
+    printf("\n%-12s  %12s  %12s  %8s\n", "hardness", "ms/level", "Mcells/s", "matches");
+    for (const char *name : noisePaths()) {
+        useNoisePath(name);
+        std::vector<int> fields;
+        double elapsed = 0;
+        for (int i = 0; i < levels; i++) {
+            auto begin = std::chrono::steady_clock::now();
+            generateHardnessAt(i, 0, 0, 0, 0, dungeonWidth, dungeonHeight);
+            elapsed += std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+            for (int y = 0; y < dungeonHeight; y++) {
+                for (int x = 0; x < dungeonWidth; x++) {
+                    fields.push_back(dungeon[y][x].hardness);
+                }
+            }
+        }
+        if (reference.empty()) {
+            reference = fields;
+        }
+        printf("%-12s  %12.3f  %12.1f  %8s\n", name, 1000.0 * elapsed / levels,
+               static_cast<double>(dungeonWidth) * dungeonHeight * levels / elapsed / 1e6, fields == reference ? "yes" : "NO");
+    }
+    useNoisePath(selected.c_str());
+    return 0;
+}
@@ -0,0 +1,188 @@
+#include <csignal>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+#include "dungeon.hpp"
+#include "latency.hpp"
+#include "trace.hpp"
+
+bool latencyEnabled = false;
+
+static std::string latencyFile;
+static int latencyBits;
+static std::vector<LatencyHistogram> turnLatency;
+static std::vector<LatencyHistogram> otherLatency;
+static int64_t inputNanos = 0;
+static int64_t transitionNanos = 0;
+static volatile sig_atomic_t dumpRequested = 0;
+
+// Slots in otherLatency, the player's turns are kept apart from the monster types
+enum { PlayerTurn, InputToFrame, LevelTransition };
+
+LatencyHistogram::LatencyHistogram(int bits) : bits(bits), counts((66 - bits) << (bits - 1), 0), total(0), max(0) {}
+
+int LatencyHistogram::bucketOf(int64_t value) const {
+    if (value < (1LL << bits)) {
+        return value;
+    }
+    int shift = 63 - __builtin_clzll(value) - (bits - 1);
+    return (shift << (bits - 1)) + (value >> shift);
+}
+
+int64_t LatencyHistogram::highestInBucket(int index) const {
+    int half = 1 << (bits - 1);
+    if (index < 2 * half) {
+        return index;
+    }
+    int shift = index / half - 1;
+    int64_t sub = index - shift * half;
+    return ((sub + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(int64_t value) {
+    if (value < 0) {
+        value = 0;
+    }
+    counts[bucketOf(value)]++;
+    total++;
+    if (value > max) {
+        max = value;
+    }
+}
+
+int64_t LatencyHistogram::percentile(double p) const {
+    if (total == 0) {
+        return 0;
+    }
+
+    uint64_t rank = static_cast<uint64_t>(p / 100.0 * total + 0.999999);
+    if (rank < 1) {
+        rank = 1;
+    }
+    uint64_t seen = 0;
+    for (size_t i = 0; i < counts.size(); i++) {
+        seen += counts[i];
+        if (seen >= rank) {
+            int64_t value = highestInBucket(i);
+            return value < max ? value : max;
+        }
+    }
+    return max;
+}
+
+LatencyTimer::LatencyTimer(LatencyHistogram *histogram) : histogram(histogram), start(histogram ? monotonicNanos() : 0) {}
+
+LatencyTimer::~LatencyTimer() {
+    if (histogram != nullptr) {
+        histogram->record(monotonicNanos() - start);
+    }
+}
+
+static void requestDump(int) {
+    dumpRequested = 1;
+}
+
+bool startLatency(const char *filename, int bits, int monsterTypes) {
+    FILE *file = fopen(filename, "w");
+    if (file == nullptr) {
+        std::cout << "Error: Cannot open latency file " << filename << std::endl;
+        return false;
+    }
+    fclose(file);
+
+    latencyFile = filename;
+    latencyBits = bits;
+    turnLatency.assign(monsterTypes, LatencyHistogram(bits));
+    otherLatency.assign(3, LatencyHistogram(bits));
+    latencyEnabled = true;
+
+    // The handler only raises a flag, the report is written from the game loop
+    struct sigaction action = {};
+    action.sa_handler = requestDump;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    sigaction(SIGUSR1, &action, nullptr);
+    return true;
+}
+
+LatencyHistogram *playerTurnLatency() {
+    return latencyEnabled ? &otherLatency[PlayerTurn] : nullptr;
+}
+
+LatencyHistogram *monsterTurnLatency(int monTypeIndex) {
+    return latencyEnabled ? &turnLatency[monTypeIndex] : nullptr;
+}
+
+void inputReceived() {
+    if (latencyEnabled) {
+        inputNanos = monotonicNanos();
+    }
+}
+
+void levelTransitionStarted() {
+    if (latencyEnabled) {
+        transitionNanos = monotonicNanos();
+    }
+}
+
+void frameCompleted() {
+    if (!latencyEnabled || (inputNanos == 0 && transitionNanos == 0)) {
+        return;
+    }
+
+    int64_t now = monotonicNanos();
+    if (inputNanos != 0) {
+        otherLatency[InputToFrame].record(now - inputNanos);
+        inputNanos = 0;
+    }
+    if (transitionNanos != 0) {
+        otherLatency[LevelTransition].record(now - transitionNanos);
+        transitionNanos = 0;
+    }
+}
+
+static void printRow(FILE *file, const char *label, const LatencyHistogram& histogram) {
+    if (histogram.getTotal() == 0) {
+        return;
+    }
+    fprintf(file, "%-26s %8lu %10.3f %10.3f %10.3f %10.3f\n", label, static_cast<unsigned long>(histogram.getTotal()),
+            histogram.percentile(50) / 1e6, histogram.percentile(99) / 1e6, histogram.percentile(99.9) / 1e6,
+            histogram.getMax() / 1e6);
+}
+
+static void writeReport() {
+    FILE *file = fopen(latencyFile.c_str(), "w");
+    if (file == nullptr) {
+        return;
+    }
+
+    fprintf(file, "Latency in ms, %d significant bits per bucket\n\n", latencyBits);
+    fprintf(file, "%-26s %8s %10s %10s %10s %10s\n", "", "count", "p50", "p99", "p99.9", "max");
+    printRow(file, "input to frame", otherLatency[InputToFrame]);
+    printRow(file, "level transition", otherLatency[LevelTransition]);
+    printRow(file, "turn: player", otherLatency[PlayerTurn]);
+    for (size_t i = 0; i < turnLatency.size(); i++) {
+        std::string label = "turn: " + monsterTypeList[i].name;
+        if (label.size() > 26) {
+            label.resize(26);
+        }
+        printRow(file, label.c_str(), turnLatency[i]);
+    }
+    fclose(file);
+}
+
+void checkLatencyDump() {
+    if (dumpRequested) {
+        dumpRequested = 0;
+        writeReport();
+    }
+}
+
+void stopLatency() {
+    if (!latencyEnabled) {
+        return;
+    }
+    writeReport();
+    latencyEnabled = false;
+}
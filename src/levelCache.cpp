@@ -0,0 +1,606 @@
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <list>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <zlib.h>
+
+#include "entityList.hpp"
+#include "generator.hpp"
+#include "globals.hpp"
+#include "levelCache.hpp"
+#include "pathFinding.hpp"
+#include "spawnTable.hpp"
+#include "trace.hpp"
+
+int depth = 0;
+
+static size_t cacheLimit = DEFAULT_LEVEL_CACHE_KB * 1024;
+static size_t cacheBytes = 0;
+// Most recently left level first
+static std::list<LevelState> cached;
+static std::unordered_map<int, std::list<LevelState>::iterator> cachedByDepth;
+static std::unordered_map<int, std::string> evicted;
+static std::string cacheDir;
+
+static std::vector<Tile> generatedTiles;
+static bool currentRegenerable = true;
+
+// A neighbor level being generated by a child process, read back from its pipe on arrival
+class PreparedLevel {
+public:
+    pid_t pid;
+    int fd;
+};
+
+static std::unordered_map<int, PreparedLevel> prepared;
+
+size_t LevelState::bytes() const {
+    return sizeof(LevelState) + tiles.size() * sizeof(Tile) + terrainDiff.size() * sizeof(TileDiff) +
+           rooms.size() * sizeof(Room) + (upStairs.size() + downStairs.size()) * sizeof(Pos) +
+           monsters.size() * sizeof(Monster) + objects.size() * sizeof(Object);
+}
+
+LevelState::~LevelState() {
+    if (arena) {
+        arena->release();
+    }
+}
+
+void setLevelCacheLimit(size_t bytes) {
+    cacheLimit = bytes;
+}
+
+void seedLevel(int levelDepth) {
+    srand(levelSeed(gameSeed, levelDepth));
+}
+
+void markGeneratedLevel(bool regenerable) {
+    generatedTiles.assign(&dungeon[0][0], &dungeon[0][0] + dungeonHeight * dungeonWidth);
+    currentRegenerable = regenerable;
+}
+
+bool writePacked(const std::string& path, const std::vector<char>& raw) {
+    uLongf packedSize = compressBound(raw.size());
+    std::vector<Bytef> packed(packedSize);
+    if (compress2(packed.data(), &packedSize, reinterpret_cast<const Bytef *>(raw.data()), raw.size(), Z_BEST_SPEED) != Z_OK) {
+        return false;
+    }
+
+    FILE *file = fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    uint32_t rawSize = raw.size();
+    bool written = fwrite(&rawSize, sizeof(rawSize), 1, file) == 1 &&
+                   fwrite(packed.data(), 1, packedSize, file) == packedSize;
+    return fclose(file) == 0 && written;
+}
+
+bool readPacked(const std::string& path, std::vector<char>& raw) {
+    FILE *file = fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        return false;
+    }
+    uint32_t rawSize = 0;
+    std::vector<Bytef> packed;
+    if (fread(&rawSize, sizeof(rawSize), 1, file) == 1) {
+        Bytef chunk[4096];
+        size_t n;
+        while ((n = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+            packed.insert(packed.end(), chunk, chunk + n);
+        }
+    }
+    fclose(file);
+    unlink(path.c_str());
+
+    raw.resize(rawSize);
+    uLongf rawLength = rawSize;
+    return rawSize != 0 && uncompress(reinterpret_cast<Bytef *>(raw.data()), &rawLength, packed.data(), packed.size()) == Z_OK;
+}
+
+// Without fullTerrain only the diff against generation is kept and the rest is regenerated from
+// the seed when the level is unpacked
+static std::vector<char> packLevel(LevelState& state, bool fullTerrain) {
+    std::vector<char> raw;
+    put(raw, state.depth);
+    put(raw, state.regenerable);
+    put(raw, fullTerrain);
+    put(raw, static_cast<uint32_t>(state.terrainDiff.size()));
+    for (const TileDiff& diff : state.terrainDiff) {
+        put(raw, diff);
+    }
+    if (fullTerrain) {
+        for (const Tile& tile : state.tiles) {
+            put(raw, tile.type);
+            put(raw, static_cast<uint8_t>(tile.hardness));
+        }
+    }
+    // What the player has seen cannot be regenerated, so it always goes along
+    for (const Tile& tile : state.tiles) {
+        put(raw, tile.visible);
+    }
+    put(raw, static_cast<uint32_t>(state.rooms.size()));
+    for (Room& room : state.rooms) {
+        put(raw, room.getPos());
+        put(raw, room.getWidth());
+        put(raw, room.getHeight());
+    }
+    put(raw, static_cast<uint32_t>(state.upStairs.size()));
+    for (Pos pos : state.upStairs) {
+        put(raw, pos);
+    }
+    put(raw, static_cast<uint32_t>(state.downStairs.size()));
+    for (Pos pos : state.downStairs) {
+        put(raw, pos);
+    }
+    put(raw, static_cast<uint32_t>(state.monsters.size()));
+    for (const auto& mon : state.monsters) {
+        put(raw, mon->getRecord());
+    }
+    put(raw, static_cast<uint32_t>(state.objects.size()));
+    for (const auto& obj : state.objects) {
+        put(raw, obj->getRecord());
+    }
+    return raw;
+}
+
+// Only the diff against generation goes to disk, plus the full terrain for a level that was loaded
+// from a save and so cannot be regenerated. The result is deflated before it is written. Returns
+// false if the level could not be written
+static bool evict(LevelState& state) {
+    TraceSpan span("evict level", "cache");
+    if (cacheDir.empty()) {
+        char dir[] = "/tmp/questvein-levels-XXXXXX";
+        if (mkdtemp(dir) == nullptr) {
+            return false;
+        }
+        cacheDir = dir;
+    }
+
+    std::string path = cacheDir + "/level" + std::to_string(state.depth) + ".lvz";
+    if (!writePacked(path, packLevel(state, !state.regenerable))) {
+        unlink(path.c_str());
+        return false;
+    }
+    evicted[state.depth] = path;
+    return true;
+}
+
+// A level that cannot be written out stays in memory over the limit rather than being lost,
+// eviction is tried again the next time a level is left
+static void evictOverLimit() {
+    while (cacheBytes > cacheLimit && !cached.empty()) {
+        LevelState& oldest = cached.back();
+        if (!evict(oldest)) {
+            break;
+        }
+        cacheBytes -= oldest.bytes();
+        cachedByDepth.erase(oldest.depth);
+        cached.pop_back();
+    }
+}
+
+// Moves the current level out of the globals and clears them
+static LevelState captureLevel(int levelDepth) {
+    LevelState state;
+    state.depth = levelDepth;
+    state.regenerable = currentRegenerable;
+    state.tiles.assign(&dungeon[0][0], &dungeon[0][0] + dungeonHeight * dungeonWidth);
+    for (size_t i = 0; i < state.tiles.size(); i++) {
+        const Tile& now = state.tiles[i];
+        const Tile& base = generatedTiles[i];
+        if (now.type != base.type || now.hardness != base.hardness) {
+            state.terrainDiff.push_back((TileDiff){static_cast<uint32_t>(i), now.type, static_cast<uint8_t>(now.hardness),
+                                                   base.type, static_cast<uint8_t>(base.hardness)});
+        }
+    }
+    state.rooms = std::vector<Room>(rooms);
+    state.upStairs = upStairs;
+    state.downStairs = downStairs;
+    state.monsters = monsterStore.entities;
+    // A pile at a time from the bottom, so it stacks back up in the same order
+    for (int i = 0; i < objectStore.size(); i++) {
+        Pos at = objectStore.pos[i];
+        if (pileHead[at.y][at.x] == i) {
+            std::vector<Object *> topDown;
+            for (Object *obj : objectsAt[at.y][at.x]) {
+                topDown.push_back(obj);
+            }
+            state.objects.insert(state.objects.end(), topDown.rbegin(), topDown.rend());
+        }
+    }
+    state.arena = takeLevelArena();
+    clearAll();
+    return state;
+}
+
+// The level's uniques and artifacts stay ineligible to spawn elsewhere while it is cached, since
+// they are still on it and come back with it
+void leaveLevel() {
+    TraceSpan span("leave level", "cache");
+    LevelState state = captureLevel(depth);
+
+    auto old = cachedByDepth.find(depth);
+    if (old != cachedByDepth.end()) {
+        cacheBytes -= old->second->bytes();
+        cached.erase(old->second);
+    }
+    evicted.erase(depth);
+    cached.push_front(std::move(state));
+    cachedByDepth[depth] = cached.begin();
+    cacheBytes += cached.front().bytes();
+    evictOverLimit();
+}
+
+static void placeEntities(std::vector<Monster *>& monsters, std::vector<Object *>& objects) {
+    for (Monster *mon : monsters) {
+        placeMonster(mon);
+        trackMonster(mon);
+    }
+    monsters.clear();
+    for (Object *obj : objects) {
+        placeObject(obj);
+        trackObject(obj);
+    }
+    objects.clear();
+}
+
+static void restoreLists(std::vector<Room>& savedRooms, std::vector<Pos>& savedUp, std::vector<Pos>& savedDown) {
+    rooms.clear();
+    for (Room& room : savedRooms) {
+        rooms.emplace_back(room);
+    }
+    roomCount = rooms.size();
+    upStairs = savedUp;
+    upStairsCount = upStairs.size();
+    downStairs = savedDown;
+    downStairsCount = downStairs.size();
+}
+
+static bool restoreFromMemory(int levelDepth) {
+    auto found = cachedByDepth.find(levelDepth);
+    if (found == cachedByDepth.end()) {
+        return false;
+    }
+
+    LevelState& state = *found->second;
+    memcpy(&dungeon[0][0], state.tiles.data(), state.tiles.size() * sizeof(Tile));
+    generatedTiles = state.tiles;
+    for (const TileDiff& diff : state.terrainDiff) {
+        generatedTiles[diff.index].type = diff.baseType;
+        generatedTiles[diff.index].hardness = diff.baseHardness;
+    }
+    currentRegenerable = state.regenerable;
+    restoreLists(state.rooms, state.upStairs, state.downStairs);
+    // Nothing has been placed on the arriving level yet, so its empty arena gives way
+    levelArena = std::move(state.arena);
+    placeEntities(state.monsters, state.objects);
+
+    cacheBytes -= state.bytes();
+    cached.erase(found->second);
+    cachedByDepth.erase(found);
+    return true;
+}
+
+static bool onMap(Pos pos) {
+    return pos.x >= 0 && pos.x < dungeonWidth && pos.y >= 0 && pos.y < dungeonHeight;
+}
+
+// A count read from a packed level, false if fewer than that many items of size bytes are left
+static bool takeCount(const std::vector<char>& raw, size_t& at, uint32_t& count, size_t size) {
+    return take(raw, at, count) && count <= (raw.size() - at) / size;
+}
+
+// Rebuilds the globals from packLevel's output. Returns false if it is truncated or names a type or
+// cell that does not exist, the caller then clears what was rebuilt so far
+static bool unpackLevel(const std::vector<char>& raw, size_t& at) {
+    int savedDepth;
+    bool regenerable, fullTerrain;
+    uint32_t count;
+    if (!take(raw, at, savedDepth) || !take(raw, at, regenerable) || !take(raw, at, fullTerrain) ||
+        !takeCount(raw, at, count, sizeof(TileDiff))) {
+        return false;
+    }
+    std::vector<TileDiff> diffs(count);
+    for (TileDiff& diff : diffs) {
+        if (!take(raw, at, diff) || diff.index >= static_cast<uint32_t>(dungeonWidth * dungeonHeight)) {
+            return false;
+        }
+    }
+
+    if (!fullTerrain) {
+        seedLevel(savedDepth);
+        initDungeon();
+        generateStructures();
+        markGeneratedLevel(regenerable);
+    }
+    else {
+        for (int y = 0; y < dungeonHeight; y++) {
+            for (int x = 0; x < dungeonWidth; x++) {
+                uint8_t hardness = 0;
+                if (!take(raw, at, dungeon[y][x].type) || !take(raw, at, hardness)) {
+                    return false;
+                }
+                dungeon[y][x].hardness = hardness;
+            }
+        }
+        markGeneratedLevel(regenerable);
+        for (const TileDiff& diff : diffs) {
+            generatedTiles[diff.index].type = diff.baseType;
+            generatedTiles[diff.index].hardness = diff.baseHardness;
+        }
+    }
+    for (const TileDiff& diff : diffs) {
+        dungeon[diff.index / dungeonWidth][diff.index % dungeonWidth].type = diff.type;
+        dungeon[diff.index / dungeonWidth][diff.index % dungeonWidth].hardness = diff.hardness;
+    }
+    for (int y = 0; y < dungeonHeight; y++) {
+        for (int x = 0; x < dungeonWidth; x++) {
+            if (!take(raw, at, dungeon[y][x].visible)) {
+                return false;
+            }
+        }
+    }
+
+    std::vector<Room> savedRooms;
+    if (!takeCount(raw, at, count, sizeof(Pos) + 2 * sizeof(int))) {
+        return false;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        Pos pos;
+        int width, height;
+        if (!take(raw, at, pos) || !take(raw, at, width) || !take(raw, at, height) || !onMap(pos) ||
+            width < 1 || height < 1 || pos.x + width > dungeonWidth || pos.y + height > dungeonHeight) {
+            return false;
+        }
+        savedRooms.emplace_back(pos, width, height);
+    }
+    std::vector<Pos> savedUp, savedDown;
+    if (!takeCount(raw, at, count, sizeof(Pos))) {
+        return false;
+    }
+    savedUp.resize(count);
+    for (Pos& pos : savedUp) {
+        if (!take(raw, at, pos) || !onMap(pos)) {
+            return false;
+        }
+    }
+    if (!takeCount(raw, at, count, sizeof(Pos))) {
+        return false;
+    }
+    savedDown.resize(count);
+    for (Pos& pos : savedDown) {
+        if (!take(raw, at, pos) || !onMap(pos)) {
+            return false;
+        }
+    }
+
+    // Records are checked before anything is allocated, so a bad one leaves nothing to free
+    std::vector<MonsterRecord> monsterRecords;
+    if (!takeCount(raw, at, count, sizeof(MonsterRecord))) {
+        return false;
+    }
+    monsterRecords.resize(count);
+    for (MonsterRecord& record : monsterRecords) {
+        if (!take(raw, at, record) || record.monTypeIndex < 0 ||
+            record.monTypeIndex >= static_cast<int>(monsterTypeList.size()) || !onMap(record.pos)) {
+            return false;
+        }
+    }
+    std::vector<ObjectRecord> objectRecords;
+    if (!takeCount(raw, at, count, sizeof(ObjectRecord))) {
+        return false;
+    }
+    objectRecords.resize(count);
+    for (ObjectRecord& record : objectRecords) {
+        if (!take(raw, at, record) || record.objTypeIndex < 0 ||
+            record.objTypeIndex >= static_cast<int>(objectTypeList.size()) || !onMap(record.pos)) {
+            return false;
+        }
+    }
+
+    restoreLists(savedRooms, savedUp, savedDown);
+    std::vector<Monster *> monsters;
+    for (const MonsterRecord& record : monsterRecords) {
+        monsters.push_back(new Monster(&monsterTypeList[record.monTypeIndex], record));
+    }
+    std::vector<Object *> objects;
+    for (const ObjectRecord& record : objectRecords) {
+        objects.push_back(new Object(&objectTypeList[record.objTypeIndex], record));
+    }
+    placeEntities(monsters, objects);
+    return true;
+}
+
+static bool restoreFromDisk(int levelDepth) {
+    auto found = evicted.find(levelDepth);
+    if (found == evicted.end()) {
+        return false;
+    }
+    TraceSpan span("restore level", "cache");
+
+    std::string path = found->second;
+    evicted.erase(found);
+    std::vector<char> raw;
+    if (!readPacked(path, raw)) {
+        return false;
+    }
+    size_t at = 0;
+    if (!unpackLevel(raw, at)) {
+        clearAll();
+        return false;
+    }
+    return true;
+}
+
+// The same steps in the same rand() order whether a level is generated here or by a child process
+static void generateLevel(int levelDepth, bool fromAbove) {
+    seedLevel(levelDepth);
+    initDungeon();
+    generateStructures();
+    markGeneratedLevel(true);
+    player.setPos(fromAbove ? upStairs.back() : downStairs.back());
+    spawnMonsters(numMonsters, player.getPos().x, player.getPos().y);
+    spawnObjects(numObjects);
+}
+
+static void discardPrepared() {
+    for (auto& entry : prepared) {
+        kill(entry.second.pid, SIGKILL);
+        close(entry.second.fd);
+        waitpid(entry.second.pid, nullptr, 0);
+    }
+    prepared.clear();
+}
+
+// Runs in a forked child with its own copy of the globals, so generating there leaves the level
+// being played untouched. The packed level is followed by the child's next entity id
+static void runPrepare(int levelDepth, bool fromAbove, int out) {
+    clearAll();
+    generateLevel(levelDepth, fromAbove);
+    LevelState state = captureLevel(levelDepth);
+    std::vector<char> raw = packLevel(state, true);
+    put(raw, nextEntityId);
+
+    size_t written = 0;
+    while (written < raw.size()) {
+        ssize_t n = write(out, raw.data() + written, raw.size() - written);
+        if (n <= 0) {
+            _exit(1);
+        }
+        written += n;
+    }
+    _exit(0);
+}
+
+static void prepare(int levelDepth) {
+    if (cachedByDepth.count(levelDepth) || evicted.count(levelDepth) || prepared.count(levelDepth)) {
+        return;
+    }
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return;
+    }
+    fflush(stdout);
+    fflush(stderr);
+    pid_t pid = fork();
+    if (pid == -1) {
+        close(fds[0]);
+        close(fds[1]);
+        return;
+    }
+    if (pid == 0) {
+        close(fds[0]);
+        runPrepare(levelDepth, levelDepth > depth, fds[1]);
+    }
+    close(fds[1]);
+    prepared[levelDepth] = (PreparedLevel){pid, fds[0]};
+}
+
+void prepareNeighbors() {
+    prepare(depth + 1);
+    prepare(depth - 1);
+}
+
+// Swaps in a level generated by prepare. Uniques and artifacts it spawned are marked as they would
+// have been had it been generated here
+static bool adoptPrepared(int levelDepth) {
+    auto found = prepared.find(levelDepth);
+    if (found == prepared.end()) {
+        return false;
+    }
+    TraceSpan span("adopt level", "cache");
+
+    PreparedLevel level = found->second;
+    prepared.erase(found);
+    std::vector<char> raw;
+    char chunk[16384];
+    ssize_t n;
+    while ((n = read(level.fd, chunk, sizeof(chunk))) > 0) {
+        raw.insert(raw.end(), chunk, chunk + n);
+    }
+    close(level.fd);
+    int status;
+    waitpid(level.pid, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0 || raw.size() < sizeof(nextEntityId)) {
+        return false;
+    }
+
+    unsigned int childEntityId;
+    memcpy(&childEntityId, raw.data() + raw.size() - sizeof(childEntityId), sizeof(childEntityId));
+    raw.resize(raw.size() - sizeof(childEntityId));
+    size_t at = 0;
+    if (!unpackLevel(raw, at)) {
+        clearAll();
+        return false;
+    }
+    nextEntityId = childEntityId;
+
+    for (int i = 0; i < monsterStore.size(); i++) {
+        if (monsterStore.flags[i] & (ABIL_UNIQ | ABIL_BOSS)) {
+            setMonsterEligible(monsterStore.entities[i]->getMonTypeIndex(), false);
+        }
+    }
+    for (Object *obj : objectStore.entities) {
+        if (obj->isArtifact()) {
+            setObjectEligible(obj->getObjTypeIndex(), false);
+        }
+    }
+    return true;
+}
+
+// A monster that was standing on the stairs steps aside for the arriving player
+static void clearArrival(Pos pos) {
+    if (!monsterAt[pos.y][pos.x]) {
+        return;
+    }
+    for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            int x = pos.x + dx;
+            int y = pos.y + dy;
+            if (dungeon[y][x].hardness == 0 && !monsterAt[y][x]) {
+                moveMonster(monsterAt[pos.y][pos.x], (Pos){x, y});
+                return;
+            }
+        }
+    }
+}
+
+void enterLevel(int levelDepth, bool fromAbove) {
+    TraceSpan span("enter level", "cache");
+    depth = levelDepth;
+    bool adopted = adoptPrepared(levelDepth);
+    // The other neighbor was generated against unique and artifact eligibility that may have
+    // changed, it is generated again once needed
+    discardPrepared();
+
+    if (adopted || restoreFromMemory(levelDepth) || restoreFromDisk(levelDepth)) {
+        terrainVersion++;
+        player.setPos(fromAbove ? upStairs.back() : downStairs.back());
+        clearArrival(player.getPos());
+    }
+    else {
+        generateLevel(levelDepth, fromAbove);
+    }
+    prepareNeighbors();
+}
+
+void clearLevelCache() {
+    discardPrepared();
+    cached.clear();
+    cachedByDepth.clear();
+    cacheBytes = 0;
+    for (const auto& entry : evicted) {
+        unlink(entry.second.c_str());
+    }
+    evicted.clear();
+    if (!cacheDir.empty()) {
+        rmdir(cacheDir.c_str());
+        cacheDir.clear();
+    }
+}
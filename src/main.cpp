@@ -5,13 +5,23 @@
 #include <ctime>
 #include <iostream>
 #include <ncurses.h>
+#include <unistd.h>
 
+#include "corpus.hpp"
 #include "display.hpp"
 #include "dungeon.hpp"
 #include "game.hpp"
+#include "generator.hpp"
 #include "globals.hpp"
+#include "latency.hpp"
+#include "levelCache.hpp"
+#include "overworld.hpp"
 #include "pathFinding.hpp"
+#include "profiler.hpp"
+#include "recorder.hpp"
+#include "renderer.hpp"
 #include "saveLoad.hpp"
+#include "trace.hpp"
 
 class SwitchInfo {
 public:
@@ -31,7 +41,27 @@ static const SwitchInfo switches[] = {
     {"-m", "--nummon", "Set the number of monsters (requires positive integer)"},
     {"-o", "--numobj", "Set the number of objects (requires positive integer)"},
     {"-a", "--auto", "Run the game in automatic (random) movement mode"},
-    {"-g", "--godmode", "Enable god mode (invincible player)"}
+    {"-g", "--godmode", "Enable god mode (invincible player)"},
+    {"-r", "--renderer", "Select the map renderer, 'ncurses' or 'ansi' (default ncurses)"},
+    {"-rb", "--render-bench", "Render N frames with each renderer, print bytes and writes per frame, and exit"},
+    {"-rec", "--record", "Record the session as an asciicast file (requires filename, uses the ansi renderer)"},
+    {"-bc", "--broadcast", "Stream the session to spectators on a Unix socket (requires path, uses the ansi renderer)"},
+    {"-sp", "--spectate", "Watch a session being broadcast on a Unix socket (requires path)"},
+    {"-st", "--stats", "Print per-phase timings and counters when the game ends"},
+    {"-tr", "--trace", "Write a Chrome trace-event timeline of the session, viewable in Perfetto (requires filename)"},
+    {"-lat", "--latency", "Write turn, input-to-frame and level transition latency percentiles to a file on exit or SIGUSR1 (requires filename)"},
+    {"-lb", "--latency-bits", "Significant bits per latency histogram bucket, 2 to 16 (default 8)"},
+    {"-gen", "--generator", "Select the level generator, 'rooms', 'bsp', 'mst' or 'cave' (default rooms)"},
+    {"-gb", "--gen-bench", "Generate N levels with each generator, print speed, fill and connectivity, and exit"},
+    {"-sd", "--seed", "Seed the game so levels and spawns can be reproduced (requires non-negative integer)"},
+    {"-gc", "--generate-corpus", "Generate N levels in parallel, save each one with a stats index, and exit"},
+    {"-th", "--threads", "Number of corpus workers (default is the number of cores)"},
+    {"-out", "--out", "Directory for the generated corpus (default corpus)"},
+    {"-dw", "--width", "Dungeon width, 80 to 2000 (default 80), the view scrolls over larger maps"},
+    {"-dh", "--height", "Dungeon height, 21 to 2000 (default 21)"},
+    {"-sb", "--scale-bench", "Time hardness, generation, spawning, pathfinding and FOV over N levels at the current size, and exit"},
+    {"-lc", "--level-cache", "Memory in KB for visited levels before they are compressed to disk (default 512)"},
+    {"-ow", "--overworld", "Explore an endless world generated in chunks around the player instead of dungeon levels"}
 };
 
 static const int numSwitches = sizeof(switches) / sizeof(SwitchInfo);
@@ -46,21 +76,46 @@ bool supportsColor;
 int numMonsters;
 int numObjects;
 
+unsigned int gameSeed;
+
+// Writes out the trace and latency report, every exit after tracing has started goes through here
+// so neither file is left truncated
+static void stopProfiling() {
+    stopLatency();
+    stopTracing();
+}
+
 int main(int argc, char *argv[]) {
-    srand(time(nullptr));
+    gameSeed = time(nullptr);
 
     bool printhardbFlag = false;
     bool printhardaFlag = false;
     bool saveFlag = false;
     bool loadFlag = false;
+    bool ansiFlag = false;
+    int benchFrames = 0;
+    int benchLevels = 0;
+    int scaleLevels = 0;
+    int width = DEFAULT_WIDTH;
+    int height = DEFAULT_HEIGHT;
+    bool statsFlag = false;
+    const char *recordFile = nullptr;
+    const char *broadcastSocket = nullptr;
+    const char *traceFile = nullptr;
+    const char *latencyFile = nullptr;
+    int latencyBits = DEFAULT_LATENCY_BITS;
+    int corpusLevels = 0;
+    int corpusWorkers = sysconf(_SC_NPROCESSORS_ONLN);
+    const char *corpusDir = "corpus";
 
     autoFlag = false;
     godmodeFlag = false;
     supportsColor = false;
 
     char filename[256];
-    numMonsters = rand() % 9 + 7;
-    numObjects = rand() % 3 + 10;
+    // Drawn from the game seed once the arguments are read, unless given on the command line
+    numMonsters = -1;
+    numObjects = -1;
 
     for (int i = 1; i < argc; i++) {
         if (!strcmp(argv[i], "-h") || !strcmp(argv[i], "--help")) {
@@ -206,40 +261,297 @@ int main(int argc, char *argv[]) {
         else if (!strcmp(argv[i], "-g") || !strcmp(argv[i], "--godmode")) {
             godmodeFlag = true;
         }
+        else if (!strcmp(argv[i], "-r") || !strcmp(argv[i], "--renderer")) {
+            if (i < argc - 1 && !strcmp(argv[i + 1], "ansi")) {
+                ansiFlag = true;
+            }
+            else if (i < argc - 1 && !strcmp(argv[i + 1], "ncurses")) {
+                ansiFlag = false;
+            }
+            else {
+                std::cout << "Error: Argument '--renderer/-r' requires 'ncurses' or 'ansi'" << std::endl;
+                return 1;
+            }
+
+            i++;
+        }
+        else if (!strcmp(argv[i], "-rb") || !strcmp(argv[i], "--render-bench")) {
+            if (i < argc - 1 && atoi(argv[i + 1]) > 0) {
+                benchFrames = atoi(argv[i + 1]);
+            }
+            else {
+                std::cout << "Error: Argument '--render-bench/-rb' requires a positive integer" << std::endl;
+                return 1;
+            }
+
+            i++;
+        }
+        else if (!strcmp(argv[i], "-rec") || !strcmp(argv[i], "--record")) {
+            if (i < argc - 1 && argv[i + 1][0] != '-') {
+                recordFile = argv[i + 1];
+            }
+            else {
+                std::cout << "Error: Argument '--record/-rec' requires a file name" << std::endl;
+                return 1;
+            }
+
+            i++;
+        }
+        else if (!strcmp(argv[i], "-bc") || !strcmp(argv[i], "--broadcast")) {
+            if (i < argc - 1 && argv[i + 1][0] != '-') {
+                broadcastSocket = argv[i + 1];
+            }
+            else {
+                std::cout << "Error: Argument '--broadcast/-bc' requires a socket path" << std::endl;
+                return 1;
+            }
+
+            i++;
+        }
+        else if (!strcmp(argv[i], "-st") || !strcmp(argv[i], "--stats")) {
+            statsFlag = true;
+        }
+        else if (!strcmp(argv[i], "-tr") || !strcmp(argv[i], "--trace")) {
+            if (i < argc - 1 && argv[i + 1][0] != '-') {
+                traceFile = argv[i + 1];
+            }
+            else {
+                std::cout << "Error: Argument '--trace/-tr' requires a file name" << std::endl;
+                return 1;
+            }
+
+            i++;
+        }
+        else if (!strcmp(argv[i], "-lat") || !strcmp(argv[i], "--latency")) {
+            if (i < argc - 1 && argv[i + 1][0] != '-') {
+                latencyFile = argv[i + 1];
+            }
+            else {
+                std::cout << "Error: Argument '--latency/-lat' requires a file name" << std::endl;
+                return 1;
+            }
+
+            i++;
+        }
+        else if (!strcmp(argv[i], "-lb") || !strcmp(argv[i], "--latency-bits")) {
+            if (i < argc - 1 && atoi(argv[i + 1]) >= 2 && atoi(argv[i + 1]) <= 16) {
+                latencyBits = atoi(argv[i + 1]);
+            }
+            else {
+                std::cout << "Error: Argument '--latency-bits/-lb' requires an integer from 2 to 16" << std::endl;
+                return 1;
+            }
+
+            i++;
+        }
+        else if (!strcmp(argv[i], "-gen") || !strcmp(argv[i], "--generator")) {
+            if (i < argc - 1 && makeGenerator(argv[i + 1]) != nullptr) {
+                generator = makeGenerator(argv[i + 1]);
+            }
+            else {
+                std::cout << "Error: Argument '--generator/-gen' requires 'rooms', 'bsp', 'mst' or 'cave'" << std::endl;
+                return 1;
+            }
+
+            i++;
+        }
+        else if (!strcmp(argv[i], "-gb") || !strcmp(argv[i], "--gen-bench")) {
+            if (i < argc - 1 && atoi(argv[i + 1]) > 0) {
+                benchLevels = atoi(argv[i + 1]);
+            }
+            else {
+                std::cout << "Error: Argument '--gen-bench/-gb' requires a positive integer" << std::endl;
+                return 1;
+            }
+
+            i++;
+        }
+        else if (!strcmp(argv[i], "-sd") || !strcmp(argv[i], "--seed")) {
+            if (i < argc - 1 && isdigit(argv[i + 1][0])) {
+                gameSeed = strtoul(argv[i + 1], nullptr, 10);
+            }
+            else {
+                std::cout << "Error: Argument '--seed/-sd' requires a non-negative integer" << std::endl;
+                return 1;
+            }
+
+            i++;
+        }
+        else if (!strcmp(argv[i], "-gc") || !strcmp(argv[i], "--generate-corpus")) {
+            if (i < argc - 1 && atoi(argv[i + 1]) > 0) {
+                corpusLevels = atoi(argv[i + 1]);
+            }
+            else {
+                std::cout << "Error: Argument '--generate-corpus/-gc' requires a positive integer" << std::endl;
+                return 1;
+            }
+
+            i++;
+        }
+        else if (!strcmp(argv[i], "-th") || !strcmp(argv[i], "--threads")) {
+            if (i < argc - 1 && atoi(argv[i + 1]) > 0) {
+                corpusWorkers = atoi(argv[i + 1]);
+            }
+            else {
+                std::cout << "Error: Argument '--threads/-th' requires a positive integer" << std::endl;
+                return 1;
+            }
+
+            i++;
+        }
+        else if (!strcmp(argv[i], "-out") || !strcmp(argv[i], "--out")) {
+            if (i < argc - 1) {
+                corpusDir = argv[i + 1];
+            }
+            else {
+                std::cout << "Error: Argument '--out/-out' requires a directory" << std::endl;
+                return 1;
+            }
+
+            i++;
+        }
+        else if (!strcmp(argv[i], "-dw") || !strcmp(argv[i], "--width")) {
+            if (i < argc - 1 && atoi(argv[i + 1]) >= VIEW_WIDTH && atoi(argv[i + 1]) <= MAX_DUNGEON_WIDTH) {
+                width = atoi(argv[i + 1]);
+            }
+            else {
+                std::cout << "Error: Argument '--width/-dw' requires an integer from " << VIEW_WIDTH << " to " << MAX_DUNGEON_WIDTH << std::endl;
+                return 1;
+            }
+
+            i++;
+        }
+        else if (!strcmp(argv[i], "-dh") || !strcmp(argv[i], "--height")) {
+            if (i < argc - 1 && atoi(argv[i + 1]) >= VIEW_HEIGHT && atoi(argv[i + 1]) <= MAX_DUNGEON_HEIGHT) {
+                height = atoi(argv[i + 1]);
+            }
+            else {
+                std::cout << "Error: Argument '--height/-dh' requires an integer from " << VIEW_HEIGHT << " to " << MAX_DUNGEON_HEIGHT << std::endl;
+                return 1;
+            }
+
+            i++;
+        }
+        else if (!strcmp(argv[i], "-sb") || !strcmp(argv[i], "--scale-bench")) {
+            if (i < argc - 1 && atoi(argv[i + 1]) > 0) {
+                scaleLevels = atoi(argv[i + 1]);
+            }
+            else {
+                std::cout << "Error: Argument '--scale-bench/-sb' requires a positive integer" << std::endl;
+                return 1;
+            }
+
+            i++;
+        }
+        else if (!strcmp(argv[i], "-lc") || !strcmp(argv[i], "--level-cache")) {
+            if (i < argc - 1 && isdigit(argv[i + 1][0])) {
+                setLevelCacheLimit(strtoul(argv[i + 1], nullptr, 10) * 1024);
+            }
+            else {
+                std::cout << "Error: Argument '--level-cache/-lc' requires a non-negative integer" << std::endl;
+                return 1;
+            }
+
+            i++;
+        }
+        else if (!strcmp(argv[i], "-ow") || !strcmp(argv[i], "--overworld")) {
+            overworldFlag = true;
+        }
+        else if (!strcmp(argv[i], "-sp") || !strcmp(argv[i], "--spectate")) {
+            if (i < argc - 1) {
+                return spectate(argv[i + 1]);
+            }
+            std::cout << "Error: Argument '--spectate/-sp' requires a socket path" << std::endl;
+            return 1;
+        }
         else {
             std::cout << "Error: Unrecognized argument, use '--help/-h' for usage information" << std::endl;
             return 1;
         }
     }
-    
+
+    srand(gameSeed);
+    if (numMonsters == -1) {
+        numMonsters = rand() % 9 + 7;
+    }
+    if (numObjects == -1) {
+        numObjects = rand() % 3 + 10;
+    }
+    if (width != DEFAULT_WIDTH || height != DEFAULT_HEIGHT) {
+        resizeDungeon(width, height);
+    }
+
+    // Started before parsing so startup shows up on the timeline too
+    if (traceFile != nullptr && !startTracing(traceFile)) {
+        return 1;
+    }
+
     if (parse("../data/object_desc.txt")) {
         std::cout << "Attempting to parse example object description file instead." << std::endl;
         if (parse("../data/object_desc.example.txt")) {
+            stopProfiling();
             return 1;
         }
     }
     if (parse("../data/monster_desc.txt")) {
         std::cout << "Attempting to parse example monster description file instead." << std::endl;
         if (parse("../data/monster_desc.example.txt")) {
+            stopProfiling();
             return 1;
         }
     }
     
-    if (loadFlag) {
+    // Needs the parsed monster types, one turn histogram per type
+    if (latencyFile != nullptr && !startLatency(latencyFile, latencyBits, monsterTypeList.size())) {
+        stopProfiling();
+        return 1;
+    }
+
+    if (corpusLevels > 0) {
+        int status = generateCorpus(corpusLevels, corpusWorkers, gameSeed, corpusDir);
+        stopProfiling();
+        return status;
+    }
+
+    if (benchLevels > 0) {
+        int status = generatorBenchmark(benchLevels);
+        stopProfiling();
+        return status;
+    }
+
+    if (scaleLevels > 0) {
+        int status = scaleBenchmark(scaleLevels);
+        stopProfiling();
+        return status;
+    }
+
+    if (overworldFlag) {
+        if (saveFlag || loadFlag || printhardbFlag) {
+            std::cout << "Error: Argument '--overworld/-ow' cannot be used with '--save/-s', '--load/-l' or '--printhardb/-hb'" << std::endl;
+            stopProfiling();
+            return 1;
+        }
+        startOverworld();
+    }
+    else if (loadFlag) {
         if (printhardbFlag) {
             std::cout << "Error: Argument '--printhardb/-hb' cannot be used with '--load/-l'" << std::endl;
+            stopProfiling();
             return 1;
         }
         loadDungeon(filename);
+        markGeneratedLevel(false);
         spawnMonsters(numMonsters, player.getPos().x, player.getPos().y);
         spawnObjects(numObjects);
     }
     else {
+        seedLevel(depth);
         initDungeon();
         if (printhardbFlag) {
             printHardness();
         }
         generateStructures();
+        markGeneratedLevel(true);
         spawnPlayer();
         spawnMonsters(numMonsters, player.getPos().x, player.getPos().y);
         spawnObjects(numObjects);
@@ -253,6 +565,31 @@ int main(int argc, char *argv[]) {
         saveDungeon(filename);
     }
 
+    if (benchFrames > 0) {
+        int status = renderBenchmark(benchFrames);
+        stopProfiling();
+        return status;
+    }
+
+    // Later stair transitions fork these workers while the recorder thread runs. That is safe
+    // because the child only generates a level: the main thread's trace buffer was registered when
+    // tracing started, so the child never takes the trace lock, and it never touches the recorder or
+    // its lock
+    if (!overworldFlag) {
+        prepareNeighbors();
+    }
+
+    // Only the ansi renderer produces a byte stream that can be recorded
+    if (recordFile != nullptr || broadcastSocket != nullptr) {
+        ansiFlag = true;
+        if (!startRecording(recordFile, broadcastSocket)) {
+            clearLevelCache();
+            clearOverworld();
+            stopProfiling();
+            return 1;
+        }
+    }
+
     initscr();
     if (autoFlag) {
         nodelay(stdscr, TRUE);
@@ -260,20 +597,20 @@ int main(int argc, char *argv[]) {
     if (has_colors()) {
         start_color();
         supportsColor = true;
-        init_pair(1, COLOR_WHITE, COLOR_BLACK);
-        init_pair(2, COLOR_RED, COLOR_BLACK);
-        init_pair(3, COLOR_GREEN, COLOR_BLACK);
-        init_pair(4, COLOR_YELLOW, COLOR_BLACK);
-        init_pair(5, COLOR_BLUE, COLOR_BLACK);
-        init_pair(6, COLOR_MAGENTA, COLOR_BLACK);
-        init_pair(7, COLOR_CYAN, COLOR_BLACK);
-        init_pair(8, COLOR_WHITE, COLOR_BLACK);
+        initColorPairs();
     }
     raw();
     noecho();
     curs_set(0);
     keypad(stdscr, TRUE);
 
+    if (ansiFlag) {
+        renderer = std::make_unique<AnsiRenderer>(STDOUT_FILENO, true);
+    }
+    else {
+        renderer = std::make_unique<NcursesRenderer>();
+    }
+
     printLine(MESSAGE_LINE, "Welcome adventurer! Press any key to begin...");
     getch();
 
@@ -281,5 +618,12 @@ int main(int argc, char *argv[]) {
         ;
 
     endwin();
+    clearLevelCache();
+    clearOverworld();
+    stopRecording();
+    stopProfiling();
+    if (statsFlag) {
+        printStats();
+    }
     return 0;
 }
@@ -0,0 +1,212 @@
+#include <bitset>
+#include <vector>
+
+#include "display.hpp"
+#include "dungeon.hpp"
+#include "game.hpp"
+#include "globals.hpp"
+#include "overlay.hpp"
+#include "pathFinding.hpp"
+#include "renderer.hpp"
+
+class OverlayCell {
+public:
+    char glyph;
+    Color color;
+};
+
+Overlay activeOverlay = Overlay::None;
+
+static const int DISTANCE_LUT_SIZE = 1024;
+static const char LABELS[] = "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+static const int LABEL_COUNT = sizeof(LABELS) - 1;
+static const Color LABEL_COLORS[] = {Color::Red, Color::Green, Color::Yellow, Color::Blue, Color::Magenta, Color::Cyan, Color::White};
+static const int LABEL_COLOR_COUNT = sizeof(LABEL_COLORS) / sizeof(Color);
+
+static OverlayCell distanceLut[DISTANCE_LUT_SIZE];
+static OverlayCell hardnessLut[MAX_HARDNESS + 1];
+static bool lutsBuilt = false;
+
+// Room and corridor labels only change with the terrain, so they are rebuilt on a version bump
+static Grid<int> regionLabels;
+static Overlay labelsFor = Overlay::None;
+static unsigned int labelsVersion = 0;
+
+static Color shade(Color c) {
+    return supportsColor ? c : Color::Default;
+}
+
+static void buildLuts() {
+    static const Color bands[] = {Color::Red, Color::Yellow, Color::Green, Color::Cyan, Color::Blue};
+    for (int d = 0; d < DISTANCE_LUT_SIZE; d++) {
+        distanceLut[d].glyph = d % 10 + '0';
+        distanceLut[d].color = shade(bands[d / 10 < 4 ? d / 10 : 4]);
+    }
+    distanceLut[0] = (OverlayCell){'@', Color::Default};
+
+    for (int h = 0; h <= MAX_HARDNESS; h++) {
+        hardnessLut[h].glyph = h * 10 / MAX_HARDNESS + '0';
+        hardnessLut[h].color = shade(h < 85 ? Color::Green : h < 170 ? Color::Yellow : Color::Red);
+    }
+    hardnessLut[0] = (OverlayCell){'.', Color::Default};
+    hardnessLut[MAX_HARDNESS] = (OverlayCell){'#', shade(Color::Magenta)};
+
+    lutsBuilt = true;
+}
+
+static OverlayCell distanceCell(int dist) {
+    if (dist == UNREACHABLE) {
+        return (OverlayCell){' ', Color::Default};
+    }
+    if (dist >= DISTANCE_LUT_SIZE) {
+        return (OverlayCell){static_cast<char>(dist % 10 + '0'), distanceLut[DISTANCE_LUT_SIZE - 1].color};
+    }
+    return distanceLut[dist];
+}
+
+static OverlayCell labelCell(int label) {
+    return (OverlayCell){LABELS[label % LABEL_COUNT], shade(LABEL_COLORS[label % LABEL_COLOR_COUNT])};
+}
+
+static void labelRooms() {
+    regionLabels.resize(dungeonWidth, dungeonHeight);
+    regionLabels.fill(-1);
+    for (size_t r = 0; r < rooms.size(); r++) {
+        Room& room = rooms[r];
+        for (int i = room.getPos().y; i < room.getPos().y + room.getHeight(); i++) {
+            for (int j = room.getPos().x; j < room.getPos().x + room.getWidth(); j++) {
+                regionLabels[i][j] = r;
+            }
+        }
+    }
+}
+
+// Connected components of corridor cells, eight-way like movement and checkCorridor
+static void labelCorridors() {
+    regionLabels.resize(dungeonWidth, dungeonHeight);
+    regionLabels.fill(-1);
+
+    int components = 0;
+    std::vector<Pos> stack;
+    for (int i = 0; i < dungeonHeight; i++) {
+        for (int j = 0; j < dungeonWidth; j++) {
+            if (dungeon[i][j].type != CORRIDOR || regionLabels[i][j] != -1) {
+                continue;
+            }
+
+            regionLabels[i][j] = components;
+            stack.push_back((Pos){j, i});
+            while (!stack.empty()) {
+                Pos pos = stack.back();
+                stack.pop_back();
+                for (int dy = -1; dy <= 1; dy++) {
+                    for (int dx = -1; dx <= 1; dx++) {
+                        int x = pos.x + dx;
+                        int y = pos.y + dy;
+                        if (x < 0 || x >= dungeonWidth || y < 0 || y >= dungeonHeight) {
+                            continue;
+                        }
+                        if (dungeon[y][x].type == CORRIDOR && regionLabels[y][x] == -1) {
+                            regionLabels[y][x] = components;
+                            stack.push_back((Pos){x, y});
+                        }
+                    }
+                }
+            }
+            components++;
+        }
+    }
+}
+
+static void refreshLabels() {
+    if (labelsFor == activeOverlay && labelsVersion == terrainVersion) {
+        return;
+    }
+    if (activeOverlay == Overlay::Rooms) {
+        labelRooms();
+    }
+    else {
+        labelCorridors();
+    }
+    labelsFor = activeOverlay;
+    labelsVersion = terrainVersion;
+}
+
+const char *overlayName(Overlay overlay) {
+    switch (overlay) {
+        case Overlay::NonTunneling: return "Non-tunneling distance map";
+        case Overlay::Tunneling: return "Tunneling distance map";
+        case Overlay::Hardness: return "Hardness map";
+        case Overlay::Fov: return "Field of view";
+        case Overlay::Rooms: return "Room IDs";
+        case Overlay::Corridors: return "Corridor components";
+        default: return "";
+    }
+}
+
+void toggleOverlay(Overlay overlay) {
+    activeOverlay = activeOverlay == overlay ? Overlay::None : overlay;
+    printDungeon();
+}
+
+void drawOverlay() {
+    if (!lutsBuilt) {
+        buildLuts();
+    }
+
+    Pos playerPos = player.getPos();
+    if (activeOverlay == Overlay::NonTunneling || activeOverlay == Overlay::Tunneling) {
+        const DistanceField& field = distancesFrom(playerPos);
+        const Grid<int>& dist = activeOverlay == Overlay::Tunneling ? field.tunneling : field.nonTunneling;
+        for (int i = viewOrigin.y; i < viewOrigin.y + VIEW_HEIGHT; i++) {
+            for (int j = viewOrigin.x; j < viewOrigin.x + VIEW_WIDTH; j++) {
+                OverlayCell cell = distanceCell(dist[i][j]);
+                renderer->drawMapChar(i, j, cell.glyph, cell.color);
+            }
+        }
+        return;
+    }
+
+    if (activeOverlay == Overlay::Hardness) {
+        for (int i = viewOrigin.y; i < viewOrigin.y + VIEW_HEIGHT; i++) {
+            for (int j = viewOrigin.x; j < viewOrigin.x + VIEW_WIDTH; j++) {
+                OverlayCell cell = hardnessLut[dungeon[i][j].hardness];
+                renderer->drawMapChar(i, j, cell.glyph, cell.color);
+            }
+        }
+    }
+    else if (activeOverlay == Overlay::Fov) {
+        std::bitset<VIEW_HEIGHT * VIEW_WIDTH> fov;
+        int radius = visionRadius();
+        for (int i = 0; i < VIEW_HEIGHT; i++) {
+            for (int j = 0; j < VIEW_WIDTH; j++) {
+                fov[i * VIEW_WIDTH + j] = inLineOfSight((Pos){viewOrigin.x + j, viewOrigin.y + i}, radius);
+            }
+        }
+        for (int i = viewOrigin.y; i < viewOrigin.y + VIEW_HEIGHT; i++) {
+            for (int j = viewOrigin.x; j < viewOrigin.x + VIEW_WIDTH; j++) {
+                if (fov[(i - viewOrigin.y) * VIEW_WIDTH + j - viewOrigin.x]) {
+                    renderer->drawMapChar(i, j, dungeon[i][j].type == ROCK ? '%' : dungeon[i][j].type, shade(Color::Yellow));
+                }
+                else {
+                    renderer->drawMapChar(i, j, ' ', Color::Default);
+                }
+            }
+        }
+    }
+    else {
+        refreshLabels();
+        for (int i = viewOrigin.y; i < viewOrigin.y + VIEW_HEIGHT; i++) {
+            for (int j = viewOrigin.x; j < viewOrigin.x + VIEW_WIDTH; j++) {
+                if (regionLabels[i][j] != -1) {
+                    OverlayCell cell = labelCell(regionLabels[i][j]);
+                    renderer->drawMapChar(i, j, cell.glyph, cell.color);
+                }
+                else {
+                    renderer->drawMapChar(i, j, dungeon[i][j].type, Color::Default);
+                }
+            }
+        }
+    }
+    renderer->drawMapChar(playerPos.y, playerPos.x, '@', Color::Default);
+}
@@ -0,0 +1,506 @@
+#include <algorithm>
+#include <cstdlib>
+#include <dirent.h>
+#include <map>
+#include <string>
+#include <unistd.h>
+
+#include "entityList.hpp"
+#include "floorIndex.hpp"
+#include "globals.hpp"
+#include "levelCache.hpp"
+#include "overworld.hpp"
+#include "pathFinding.hpp"
+#include "perlin.hpp"
+#include "renderer.hpp"
+#include "spawnTable.hpp"
+#include "trace.hpp"
+
+static const int WINDOW_SIZE = CHUNK_SIZE * WINDOW_CHUNKS;
+static const int SLOTS = WINDOW_CHUNKS * WINDOW_CHUNKS;
+
+bool overworldFlag = false;
+
+// World chunk coordinates of the window's top left chunk
+static int originX = -1;
+static int originY = -1;
+// Row major, slot 4 is the player's chunk
+static std::vector<Chunk> loaded(SLOTS);
+static std::string chunkDir;
+// Chunks that left the window but could not be written out, kept whole until they come back
+static std::map<std::pair<int, int>, Chunk> held;
+
+static uint32_t mix(uint32_t h) {
+    h ^= h >> 16;
+    h *= 0x7feb352du;
+    h ^= h >> 15;
+    h *= 0x846ca68bu;
+    h ^= h >> 16;
+    return h;
+}
+
+static uint32_t chunkHash(int cx, int cy, uint32_t salt) {
+    return mix(gameSeed ^ mix(static_cast<uint32_t>(cx) * 0x9e3779b1u ^ static_cast<uint32_t>(cy) * 0x85ebca77u ^ salt));
+}
+
+// Where the passage through the east (or south) edge of a chunk crosses it, the neighbor on the other
+// side asks for the same edge and so digs to the same spot
+static int portalOffset(int cx, int cy, bool east) {
+    return chunkHash(cx, cy, east ? 0xea57u : 0x5007u) % (CHUNK_SIZE - 8) + 4;
+}
+
+static Pos slotOrigin(int slot) {
+    return (Pos){slot % WINDOW_CHUNKS * CHUNK_SIZE, slot / WINDOW_CHUNKS * CHUNK_SIZE};
+}
+
+static int floorDiv(int a, int b) {
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+static bool inWindow(Pos pos) {
+    return pos.x >= 0 && pos.x < WINDOW_SIZE && pos.y >= 0 && pos.y < WINDOW_SIZE;
+}
+
+static bool onWindowEdge(int x, int y) {
+    return x == 0 || y == 0 || x == WINDOW_SIZE - 1 || y == WINDOW_SIZE - 1;
+}
+
+static Pos toWindow(Pos world) {
+    return (Pos){world.x - originX * CHUNK_SIZE, world.y - originY * CHUNK_SIZE};
+}
+
+static Pos toWorld(Pos window) {
+    return (Pos){window.x + originX * CHUNK_SIZE, window.y + originY * CHUNK_SIZE};
+}
+
+static std::string chunkPath(int cx, int cy) {
+    return chunkDir + "/chunk" + std::to_string(cx) + "_" + std::to_string(cy) + ".cvz";
+}
+
+// Returns false if the chunk could not be written, it is then still whole and up to the caller
+static bool pageOut(Chunk& chunk) {
+    TraceSpan span("page out chunk", "overworld");
+    if (chunkDir.empty()) {
+        char dir[] = "/tmp/questvein-chunks-XXXXXX";
+        if (mkdtemp(dir) == nullptr) {
+            return false;
+        }
+        chunkDir = dir;
+    }
+
+    std::vector<char> raw;
+    for (const Tile& tile : chunk.tiles) {
+        put(raw, tile.type);
+        put(raw, static_cast<uint8_t>(tile.hardness));
+        put(raw, tile.visible);
+    }
+    put(raw, static_cast<uint32_t>(chunk.rooms.size()));
+    for (Room& room : chunk.rooms) {
+        put(raw, room.getPos());
+        put(raw, room.getWidth());
+        put(raw, room.getHeight());
+    }
+    put(raw, static_cast<uint32_t>(chunk.monsters.size()));
+    for (const auto& mon : chunk.monsters) {
+        put(raw, mon->getRecord());
+    }
+    put(raw, static_cast<uint32_t>(chunk.objects.size()));
+    for (const auto& obj : chunk.objects) {
+        put(raw, obj->getRecord());
+    }
+    if (!writePacked(chunkPath(chunk.cx, chunk.cy), raw)) {
+        unlink(chunkPath(chunk.cx, chunk.cy).c_str());
+        return false;
+    }
+    return true;
+}
+
+// Reads back a chunk paged out earlier, returns false if it never was
+static bool pageIn(Chunk& chunk) {
+    auto kept = held.find(std::make_pair(chunk.cx, chunk.cy));
+    if (kept != held.end()) {
+        chunk = std::move(kept->second);
+        held.erase(kept);
+        return true;
+    }
+
+    std::vector<char> raw;
+    if (chunkDir.empty() || access(chunkPath(chunk.cx, chunk.cy).c_str(), F_OK) != 0 ||
+        !readPacked(chunkPath(chunk.cx, chunk.cy), raw)) {
+        return false;
+    }
+    TraceSpan span("page in chunk", "overworld");
+
+    size_t at = 0;
+    chunk.tiles.resize(CHUNK_SIZE * CHUNK_SIZE);
+    for (Tile& tile : chunk.tiles) {
+        uint8_t hardness = 0;
+        take(raw, at, tile.type);
+        take(raw, at, hardness);
+        take(raw, at, tile.visible);
+        tile.hardness = hardness;
+    }
+    uint32_t count = 0;
+    take(raw, at, count);
+    for (uint32_t i = 0; i < count; i++) {
+        Pos pos;
+        int width, height;
+        take(raw, at, pos);
+        take(raw, at, width);
+        take(raw, at, height);
+        chunk.rooms.emplace_back(pos, width, height);
+    }
+    take(raw, at, count);
+    for (uint32_t i = 0; i < count; i++) {
+        MonsterRecord record;
+        take(raw, at, record);
+        chunk.monsters.push_back(new Monster(&monsterTypeList[record.monTypeIndex], record));
+    }
+    take(raw, at, count);
+    for (uint32_t i = 0; i < count; i++) {
+        ObjectRecord record;
+        take(raw, at, record);
+        chunk.objects.push_back(new Object(&objectTypeList[record.objTypeIndex], record));
+    }
+    return true;
+}
+
+// Keeps a slot's terrain in its chunk, all but the hardened window edge which the chunk already
+// holds correctly
+static void captureChunk(int slot) {
+    Chunk& chunk = loaded[slot];
+    Pos at = slotOrigin(slot);
+    for (int y = 0; y < CHUNK_SIZE; y++) {
+        for (int x = 0; x < CHUNK_SIZE; x++) {
+            int wx = at.x + x;
+            int wy = at.y + y;
+            if (!onWindowEdge(wx, wy)) {
+                chunk.tiles[y * CHUNK_SIZE + x] = dungeon[wy][wx];
+            }
+        }
+    }
+}
+
+static Chunk& chunkAt(Pos window) {
+    return loaded[window.y / CHUNK_SIZE * WINDOW_CHUNKS + window.x / CHUNK_SIZE];
+}
+
+// Hands every entity in the window to the chunk it stands in, in world coordinates. The stores
+// still list them until clearAll
+static void captureEntities() {
+    for (Monster *mon : monsterStore.entities) {
+        chunkAt(mon->getPos()).monsters.push_back(mon);
+        mon->setPos(toWorld(mon->getPos()));
+        if (mon->getLastSeen().x != -1 && mon->getLastSeen().y != -1) {
+            mon->setLastSeen(toWorld(mon->getLastSeen()));
+        }
+    }
+    // A pile at a time from the bottom, so it stacks back up in the same order. Positions come from
+    // the store, which stays in window coordinates
+    for (int i = 0; i < objectStore.size(); i++) {
+        Pos at = objectStore.pos[i];
+        if (pileHead[at.y][at.x] != i) {
+            continue;
+        }
+        std::vector<Object *> topDown;
+        for (Object *obj : objectsAt[at.y][at.x]) {
+            topDown.push_back(obj);
+        }
+        Chunk& chunk = chunkAt(at);
+        for (auto onPile = topDown.rbegin(); onPile != topDown.rend(); ++onPile) {
+            (*onPile)->setPos(toWorld((*onPile)->getPos()));
+            chunk.objects.push_back(*onPile);
+        }
+    }
+}
+
+static void installChunk(int slot) {
+    Chunk& chunk = loaded[slot];
+    Pos at = slotOrigin(slot);
+    for (int y = 0; y < CHUNK_SIZE; y++) {
+        std::copy(chunk.tiles.begin() + y * CHUNK_SIZE, chunk.tiles.begin() + (y + 1) * CHUNK_SIZE, &dungeon[at.y + y][at.x]);
+    }
+    for (Monster *mon : chunk.monsters) {
+        mon->setPos(toWindow(mon->getPos()));
+        // Whatever it was chasing may now be out of the window
+        if (mon->getLastSeen().x != -1 && mon->getLastSeen().y != -1) {
+            Pos lastSeen = toWindow(mon->getLastSeen());
+            mon->setLastSeen(inWindow(lastSeen) ? lastSeen : (Pos){-1, -1});
+        }
+        placeMonster(mon);
+        trackMonster(mon);
+    }
+    chunk.monsters.clear();
+    for (Object *obj : chunk.objects) {
+        obj->setPos(toWindow(obj->getPos()));
+        placeObject(obj);
+        trackObject(obj);
+    }
+    chunk.objects.clear();
+}
+
+// Wanders from a room to a cell on the chunk edge
+static void digToEdge(Room& from, Pos edge) {
+    Room target((Pos){edge.x - 1, edge.y - 1}, 3, 3);
+    digCorridor(from, target);
+    dungeon[edge.y][edge.x].type = CORRIDOR;
+    dungeon[edge.y][edge.x].hardness = 0;
+}
+
+// Terrain and rooms for a slot, always the same for the same chunk and game seed
+static void carveChunk(int slot) {
+    TraceSpan span("carve chunk", "overworld");
+    Chunk& chunk = loaded[slot];
+    Pos at = slotOrigin(slot);
+    srand(chunkHash(chunk.cx, chunk.cy, 0));
+
+    generateHardnessAt(gameSeed, chunk.cx * CHUNK_SIZE, chunk.cy * CHUNK_SIZE, at.x, at.y, CHUNK_SIZE, CHUNK_SIZE);
+    for (int y = at.y; y < at.y + CHUNK_SIZE; y++) {
+        for (int x = at.x; x < at.x + CHUNK_SIZE; x++) {
+            dungeon[y][x].type = ROCK;
+            dungeon[y][x].visible = FOG;
+        }
+    }
+    buildFloorSums();
+
+    // Rooms keep two cells off the chunk edge, the one cell margin placeRoom checks stays inside the chunk
+    std::vector<Room> carved;
+    int count = rand() % 3 + 4;
+    for (int i = 0; i < count; i++) {
+        for (int j = 0; j < ATTEMPTS; j++) {
+            int width = rand() % 9 + 4;
+            int height = rand() % 10 + 3;
+            int x = at.x + 2 + rand() % (CHUNK_SIZE - width - 4);
+            int y = at.y + 2 + rand() % (CHUNK_SIZE - height - 4);
+            Room room((Pos){x, y}, width, height);
+            if (placeRoom(room)) {
+                carved.emplace_back(room);
+                break;
+            }
+        }
+    }
+    for (size_t i = 0; i + 1 < carved.size(); i++) {
+        digCorridor(carved[i], carved[i + 1]);
+    }
+    digToEdge(carved[rand() % carved.size()], (Pos){at.x, at.y + portalOffset(chunk.cx - 1, chunk.cy, true)});
+    digToEdge(carved[rand() % carved.size()], (Pos){at.x + CHUNK_SIZE - 1, at.y + portalOffset(chunk.cx, chunk.cy, true)});
+    digToEdge(carved[rand() % carved.size()], (Pos){at.x + portalOffset(chunk.cx, chunk.cy - 1, false), at.y});
+    digToEdge(carved[rand() % carved.size()], (Pos){at.x + portalOffset(chunk.cx, chunk.cy, false), at.y + CHUNK_SIZE - 1});
+
+    chunk.rooms.clear();
+    for (Room& room : carved) {
+        chunk.rooms.emplace_back(toWorld(room.getPos()), room.getWidth(), room.getHeight());
+    }
+}
+
+// Half a level's worth of monsters and objects per chunk, in its rooms but never in the player's
+static void populateChunk(int slot) {
+    TraceSpan span("populate chunk", "overworld");
+    std::vector<Room> windowRooms;
+    for (Room& room : loaded[slot].rooms) {
+        windowRooms.emplace_back(toWindow(room.getPos()), room.getWidth(), room.getHeight());
+    }
+
+    static FloorIndex index;
+    index.build(windowRooms, false);
+    std::vector<bool> allowed(index.groupCount(), true);
+    if (index.groupAt(player.getPos()) != -1) {
+        allowed[index.groupAt(player.getPos())] = false;
+    }
+
+    for (int i = 0; i < numMonsters / 2; i++) {
+        Pos at = index.sample(allowed);
+        while (at.x != -1 && monsterAt[at.y][at.x]) {
+            index.remove(at);
+            at = index.sample(allowed);
+        }
+        if (at.x == -1) {
+            break;
+        }
+
+        int monTypeIndex = pickMonsterType();
+        if (monTypeIndex == -1) {
+            break;
+        }
+
+        Monster *mon = new Monster(&monsterTypeList[monTypeIndex], monTypeIndex, at);
+        placeMonster(mon);
+        trackMonster(mon);
+        index.remove(at);
+        if (mon->isUnique() || mon->isBoss()) {
+            setMonsterEligible(monTypeIndex, false);
+        }
+    }
+
+    // Objects may share a cell with each other and with monsters, just not with the player
+    index.build(windowRooms, false);
+    index.remove(player.getPos());
+    allowed.assign(index.groupCount(), true);
+    for (int i = 0; i < numObjects / 2; i++) {
+        Pos at = index.sample(allowed);
+        if (at.x == -1) {
+            break;
+        }
+
+        int objTypeIndex = pickObjectType();
+        if (objTypeIndex == -1) {
+            break;
+        }
+
+        Object *obj = new Object(&objectTypeList[objTypeIndex], objTypeIndex, at);
+        placeObject(obj);
+        trackObject(obj);
+        if (obj->isArtifact()) {
+            setObjectEligible(objTypeIndex, false);
+        }
+    }
+}
+
+// Snapshots every slot's true terrain, then hardens the window edge so nothing walks or digs off the
+// map, and lists the loaded rooms for the game
+static void finishWindow() {
+    rooms.clear();
+    for (int slot = 0; slot < SLOTS; slot++) {
+        Chunk& chunk = loaded[slot];
+        Pos at = slotOrigin(slot);
+        chunk.tiles.resize(CHUNK_SIZE * CHUNK_SIZE);
+        for (int y = 0; y < CHUNK_SIZE; y++) {
+            std::copy(&dungeon[at.y + y][at.x], &dungeon[at.y + y][at.x] + CHUNK_SIZE, chunk.tiles.begin() + y * CHUNK_SIZE);
+        }
+        for (Room& room : chunk.rooms) {
+            rooms.emplace_back(toWindow(room.getPos()), room.getWidth(), room.getHeight());
+        }
+    }
+    roomCount = rooms.size();
+
+    for (int i = 0; i < WINDOW_SIZE; i++) {
+        dungeon[0][i].hardness = MAX_HARDNESS;
+        dungeon[WINDOW_SIZE - 1][i].hardness = MAX_HARDNESS;
+        dungeon[i][0].hardness = MAX_HARDNESS;
+        dungeon[i][WINDOW_SIZE - 1].hardness = MAX_HARDNESS;
+    }
+    buildFloorSums();
+    terrainVersion++;
+}
+
+void startOverworld() {
+    TraceSpan span("start overworld", "overworld");
+    resizeDungeon(WINDOW_SIZE, WINDOW_SIZE);
+    originX = -1;
+    originY = -1;
+    for (int slot = 0; slot < SLOTS; slot++) {
+        loaded[slot] = Chunk();
+        loaded[slot].cx = originX + slot % WINDOW_CHUNKS;
+        loaded[slot].cy = originY + slot / WINDOW_CHUNKS;
+        loaded[slot].present = true;
+    }
+
+    // The middle chunk first, so the player is standing somewhere before anything spawns
+    int middle = SLOTS / 2;
+    carveChunk(middle);
+    Room& first = loaded[middle].rooms.front();
+    player.setPos(toWindow((Pos){first.getPos().x + first.getWidth() / 2, first.getPos().y + first.getHeight() / 2}));
+    populateChunk(middle);
+    for (int slot = 0; slot < SLOTS; slot++) {
+        if (slot != middle) {
+            carveChunk(slot);
+            populateChunk(slot);
+        }
+    }
+    finishWindow();
+}
+
+bool recenterOverworld() {
+    Pos pos = player.getPos();
+    int dx = floorDiv(pos.x, CHUNK_SIZE) - WINDOW_CHUNKS / 2;
+    int dy = floorDiv(pos.y, CHUNK_SIZE) - WINDOW_CHUNKS / 2;
+    if (dx == 0 && dy == 0) {
+        return false;
+    }
+    TraceSpan span("recenter overworld", "overworld");
+
+    for (int slot = 0; slot < SLOTS; slot++) {
+        captureChunk(slot);
+    }
+    captureEntities();
+    // The chunks still hold entities from the window's arena, so it stays out of clearAll's way
+    std::unique_ptr<LevelArena> arena = takeLevelArena();
+    clearAll();
+    levelArena = std::move(arena);
+    originX += dx;
+    originY += dy;
+
+    std::vector<Chunk> next(SLOTS);
+    for (Chunk& chunk : loaded) {
+        int sx = chunk.cx - originX;
+        int sy = chunk.cy - originY;
+        if (sx >= 0 && sx < WINDOW_CHUNKS && sy >= 0 && sy < WINDOW_CHUNKS) {
+            next[sy * WINDOW_CHUNKS + sx] = std::move(chunk);
+        }
+        // Like a level the cache cannot write, a chunk that cannot be paged out stays in memory
+        else if (!pageOut(chunk)) {
+            held[std::make_pair(chunk.cx, chunk.cy)] = std::move(chunk);
+        }
+        else {
+            for (Monster *mon : chunk.monsters) {
+                delete mon;
+            }
+            for (Object *obj : chunk.objects) {
+                delete obj;
+            }
+        }
+    }
+    loaded = std::move(next);
+
+    player.setPos((Pos){pos.x - dx * CHUNK_SIZE, pos.y - dy * CHUNK_SIZE});
+    viewOrigin.x = std::max(0, viewOrigin.x - dx * CHUNK_SIZE);
+    viewOrigin.y = std::max(0, viewOrigin.y - dy * CHUNK_SIZE);
+
+    std::vector<int> missing;
+    for (int slot = 0; slot < SLOTS; slot++) {
+        Chunk& chunk = loaded[slot];
+        if (!chunk.present) {
+            chunk.cx = originX + slot % WINDOW_CHUNKS;
+            chunk.cy = originY + slot / WINDOW_CHUNKS;
+            chunk.present = true;
+            if (!pageIn(chunk)) {
+                missing.push_back(slot);
+                continue;
+            }
+        }
+        installChunk(slot);
+    }
+    for (int slot : missing) {
+        carveChunk(slot);
+        populateChunk(slot);
+    }
+    finishWindow();
+    return true;
+}
+
+void clearOverworld() {
+    for (auto& entry : held) {
+        for (Monster *mon : entry.second.monsters) {
+            delete mon;
+        }
+        for (Object *obj : entry.second.objects) {
+            delete obj;
+        }
+    }
+    held.clear();
+    if (chunkDir.empty()) {
+        return;
+    }
+    DIR *dir = opendir(chunkDir.c_str());
+    if (dir != nullptr) {
+        struct dirent *entry;
+        while ((entry = readdir(dir)) != nullptr) {
+            if (entry->d_name[0] != '.') {
+                unlink((chunkDir + "/" + entry->d_name).c_str());
+            }
+        }
+        closedir(dir);
+    }
+    rmdir(chunkDir.c_str());
+    chunkDir.clear();
+}
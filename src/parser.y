@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "parser.hpp"
+#include "trace.hpp"
 
 extern "C" int yylex();
 extern "C" int yyparse();
@@ -17,6 +18,7 @@ MonsterType curr_monster;
 ObjectType curr_object;
 
 int parse(const char *filename) {
+    TraceSpan span("parse", "io");
     yyin = fopen(filename, "r");
     if (!yyin) {
         std::cerr << "Cannot open file: " << filename << std::endl;
@@ -94,6 +96,8 @@ monster: BEGIN_MONSTER monster_fields END_MONSTER {
                 std::cerr << "Parse error: Invalid monster (incomplete or duplicate), discarding" << std::endl;
             }
             else {
+                curr_monster.proto.colors = compileColors(curr_monster.colors);
+                curr_monster.proto.abilities = compileAbilities(curr_monster.abils);
                 monsterTypeList.push_back(curr_monster);
             }
             reset_monster();
@@ -104,6 +108,7 @@ object: BEGIN_OBJECT object_fields END_OBJECT {
                 curr_object.valid = false;
                 std::cerr << "Parse error: Invalid object" << std::endl;
             }
+            curr_object.proto = compileObjectTypes(curr_object.types, curr_object.colors);
             objectTypeList.push_back(curr_object);
             reset_object();
         }
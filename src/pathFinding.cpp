@@ -2,12 +2,22 @@
 
 #include "dungeon.hpp"
 #include "fibonacciHeap.hpp"
+#include "pathFinding.hpp"
+#include "profiler.hpp"
+#include "trace.hpp"
 
-int tunnelingDistances(Pos pos) {
+unsigned int terrainVersion = 0;
+
+// A handful of recent sources covers the player plus the last-seen spots monsters chase
+static const int DISTANCE_CACHE_SIZE = 4;
+static DistanceField distanceCache[DISTANCE_CACHE_SIZE];
+static int nextCacheSlot = 0;
+
+static int tunnelingDistances(Pos pos, Grid<int>& distances) {
     std::unique_ptr<FibHeap> heap = std::make_unique<FibHeap>();
-    FibNode *nodes[MAX_HEIGHT][MAX_WIDTH] = {nullptr};
+    Grid<FibNode *> nodes(dungeonWidth, dungeonHeight);
 
-    dungeon[pos.y][pos.x].tunnelingDist = 0;
+    distances[pos.y][pos.x] = 0;
     nodes[pos.y][pos.x] = heap.get()->insertNew(0, pos);
 
     while (heap.get()->getMin() != nullptr) {
@@ -27,8 +37,8 @@ int tunnelingDistances(Pos pos) {
                 }
     
                 int newDist = dist + dungeon[newY][newX].hardness / 85 + 1;
-                if (newDist < dungeon[newY][newX].tunnelingDist) {
-                    dungeon[newY][newX].tunnelingDist = newDist;
+                if (newDist < distances[newY][newX]) {
+                    distances[newY][newX] = newDist;
 
                     if (nodes[newY][newX] == nullptr) {
                         nodes[newY][newX] = heap.get()->insertNew(newDist, (Pos){newX, newY});
@@ -44,11 +54,11 @@ int tunnelingDistances(Pos pos) {
     return 0;
 }
 
-int nonTunnelingDistances(Pos pos) {
+static int nonTunnelingDistances(Pos pos, Grid<int>& distances) {
     std::unique_ptr<FibHeap> heap = std::make_unique<FibHeap>();
-    FibNode *nodes[MAX_HEIGHT][MAX_WIDTH] = {nullptr};
+    Grid<FibNode *> nodes(dungeonWidth, dungeonHeight);
 
-    dungeon[pos.y][pos.x].nonTunnelingDist = 0;
+    distances[pos.y][pos.x] = 0;
     nodes[pos.y][pos.x] = heap.get()->insertNew(0, pos);
 
     while (heap.get()->getMin() != nullptr) {
@@ -67,8 +77,8 @@ int nonTunnelingDistances(Pos pos) {
                 }
     
                 int newDist = dist + 1;
-                if (newDist < dungeon[newY][newX].nonTunnelingDist) {
-                    dungeon[newY][newX].nonTunnelingDist = newDist;
+                if (newDist < distances[newY][newX]) {
+                    distances[newY][newX] = newDist;
 
                     if (nodes[newY][newX] == nullptr) {
                         nodes[newY][newX] = heap.get()->insertNew(newDist, (Pos){newX, newY});
@@ -84,15 +94,35 @@ int nonTunnelingDistances(Pos pos) {
     return 0;
 }
 
-int generateDistances(Pos pos) {
-    for (int i = 0; i < MAX_HEIGHT; i++) {
-        for (int j = 0; j < MAX_WIDTH; j++) {
-            dungeon[i][j].tunnelingDist = UNREACHABLE;
-            dungeon[i][j].nonTunnelingDist = UNREACHABLE;
+const DistanceField& distancesFrom(Pos pos) {
+    for (DistanceField& field : distanceCache) {
+        if (field.valid && field.terrainVersion == terrainVersion && field.source == pos) {
+            return field;
         }
     }
-    tunnelingDistances(pos);
-    nonTunnelingDistances(pos);
 
-    return 0;
+    countEvent(Counter::DistanceFieldBuilds);
+    TraceSpan span("build distance field", "pathfinding");
+    DistanceField& field = distanceCache[nextCacheSlot];
+    nextCacheSlot = (nextCacheSlot + 1) % DISTANCE_CACHE_SIZE;
+
+    if (field.tunneling.getWidth() != dungeonWidth || field.tunneling.getHeight() != dungeonHeight) {
+        field.tunneling.resize(dungeonWidth, dungeonHeight);
+        field.nonTunneling.resize(dungeonWidth, dungeonHeight);
+    }
+    field.tunneling.fill(UNREACHABLE);
+    field.nonTunneling.fill(UNREACHABLE);
+    tunnelingDistances(pos, field.tunneling);
+    nonTunnelingDistances(pos, field.nonTunneling);
+    field.source = pos;
+    field.terrainVersion = terrainVersion;
+    field.valid = true;
+
+    return field;
+}
+
+const DistanceField& generateDistances(Pos pos) {
+    PhaseProbe probe(Phase::Pathfinding);
+    countEvent(Counter::PathfindingCalls);
+    return distancesFrom(pos);
 }
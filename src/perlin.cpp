@@ -1,33 +1,82 @@
 #define _USE_MATH_DEFINES
 
+#include <climits>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define PERLIN_X86
+#endif
 
 #include "dungeon.hpp"
+#include "perlin.hpp"
+#include "trace.hpp"
+
+static const int GRADIENTS = 16;
+static const float BASE_FREQUENCY = 0.12f;
 
-class Gradient {
+// A seed's lattice hashing. The lattice repeats every 256 cells of the lowest octave, well past the
+// largest map
+class NoiseTables {
 public:
-    float x;
-    float y;
+    unsigned int seed;
+    int perm[512];
+    float gradX[GRADIENTS];
+    float gradY[GRADIENTS];
 };
 
-Gradient grads[MAX_HEIGHT][MAX_WIDTH];
+static NoiseTables tables;
+static bool tablesBuilt = false;
 
-void initGrads() {
-    for (int i = 0; i < MAX_HEIGHT; i++) {
-        for (int j = 0; j < MAX_WIDTH; j++) {
-            float angle = ((float)rand() / RAND_MAX) * 2.0 * M_PI;
-            grads[i][j].x = cos(angle);
-            grads[i][j].y = sin(angle);
-        }
+// One octave's gradients at each lattice column the rows cross, for the lattice rows above and below
+// them. Rows between the same two lattice rows share them, and the next pair reuses the lower row
+class LatticeColumns {
+public:
+    int iy;
+    int column;
+    int columns;
+    std::vector<float> row0X, row0Y, row1X, row1Y;
+};
+
+static LatticeColumns lattice[HARDNESS_OCTAVES];
+static std::vector<float> noise;
+static std::vector<int> hardness;
+
+static const NoiseTables& tablesFor(unsigned int seed) {
+    if (tablesBuilt && tables.seed == seed) {
+        return tables;
+    }
+    tables.seed = seed;
+    for (int i = 0; i < 256; i++) {
+        tables.perm[i] = i;
+    }
+    // Its own generator, so building the tables never moves rand()
+    uint32_t state = seed * 2654435761u + 1;
+    for (int i = 255; i > 0; i--) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        int j = state % (i + 1);
+        std::swap(tables.perm[i], tables.perm[j]);
+    }
+    for (int i = 0; i < 256; i++) {
+        tables.perm[i + 256] = tables.perm[i];
     }
+    for (int i = 0; i < GRADIENTS; i++) {
+        tables.gradX[i] = cosf(i * 2.0f * M_PI / GRADIENTS);
+        tables.gradY[i] = sinf(i * 2.0f * M_PI / GRADIENTS);
+    }
+    tablesBuilt = true;
+    return tables;
 }
 
-float dotGridGrad(int ix, int iy, float x, float y) {
-    float dx = x - (float)ix;
-    float dy = y - (float)iy;
-
-    return (dx * grads[iy][ix].x + dy * grads[iy][ix].y);
+static int latticeHash(const NoiseTables& t, int octave, int ix, int iy) {
+    return t.perm[(t.perm[(ix + octave * 101) & 255] + iy + octave * 37) & 255] % GRADIENTS;
 }
 
 float fade(float t) {
@@ -38,35 +87,328 @@ float lerp(float a, float b, float t) {
     return a + t * (b - a);
 }
 
-float perlin(float x, float y) {
-    int x0 = (int)x;
-    int y0 = (int)y;
-    int x1 = x0 + 1;
-    int y1 = y0 + 1;
+// What one kernel call needs for one octave of one row. Cell i sits at x = (first + i) * frequency,
+// its lattice column gradients are at x - column in the gradient rows
+class OctaveRow {
+public:
+    int first;
+    int column;
+    float frequency;
+    float amplitude;
+    float ty;
+    float v;
+    const float *row0X;
+    const float *row0Y;
+    const float *row1X;
+    const float *row1Y;
+};
 
-    float n0 = dotGridGrad(x0, y0, x, y);
-    float n1 = dotGridGrad(x1, y0, x, y);
-    float ix0 = lerp(n0, n1, fade(x - (float)x0));
+// Every kernel does the same float operations in the same order, so they agree to the bit
 
-    n0 = dotGridGrad(x0, y1, x, y);
-    n1 = dotGridGrad(x1, y1, x, y);
-    float ix1 = lerp(n0, n1, fade(x - (float)x0));
+static void octaveScalar(const OctaveRow& row, int from, int count, float *out) {
+    for (int i = from; i < count; i++) {
+        float fx = (float)(row.first + i) * row.frequency;
+        int ix = (int)floorf(fx);
+        int k = ix - row.column;
+        float tx = fx - (float)ix;
 
-    return lerp(ix0, ix1, fade(y - (float)y0));
+        float n00 = row.row0X[k] * tx + row.row0Y[k] * row.ty;
+        float n10 = row.row0X[k + 1] * (tx - 1) + row.row0Y[k + 1] * row.ty;
+        float n01 = row.row1X[k] * tx + row.row1Y[k] * (row.ty - 1);
+        float n11 = row.row1X[k + 1] * (tx - 1) + row.row1Y[k + 1] * (row.ty - 1);
+        float u = fade(tx);
+        float value = lerp(lerp(n00, n10, u), lerp(n01, n11, u), row.v);
+        out[i] = out[i] + row.amplitude * value;
+    }
 }
 
-void generateHardness() {
-    initGrads();
+// Pushes noise away from zero and maps it onto hardness 1 to 254
+static void finishScalar(int from, int count, float scale, const float *in, int *out) {
+    for (int i = from; i < count; i++) {
+        float value = fmaxf(-1.0f, fminf(1.0f, in[i] * scale));
+        float a = fabsf(value);
+        float pushed = 1 - (1 - a) * (1 - a);
+        value = value < 0 ? -pushed : pushed;
+        out[i] = (int)(((value + 1) * 0.5f) * 253) + 1;
+    }
+}
+
+#ifdef PERLIN_X86
+[[gnu::always_inline]] static inline __m128 fadeSse(__m128 t) {
+    __m128 inner = _mm_add_ps(_mm_mul_ps(t, _mm_sub_ps(_mm_mul_ps(t, _mm_set1_ps(6)), _mm_set1_ps(15))), _mm_set1_ps(10));
+    return _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(t, t), t), inner);
+}
+
+[[gnu::always_inline]] static inline __m128 lerpSse(__m128 a, __m128 b, __m128 t) {
+    return _mm_add_ps(a, _mm_mul_ps(t, _mm_sub_ps(b, a)));
+}
+
+// SSE2 has no gather or floor, the lattice columns are loaded one lane at a time
+static int octaveSse(const OctaveRow& row, int count, float *out) {
+    const __m128 one = _mm_set1_ps(1);
+    const __m128 ty = _mm_set1_ps(row.ty);
+    const __m128 ty1 = _mm_set1_ps(row.ty - 1);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i cells = _mm_add_epi32(_mm_set1_epi32(row.first + i), _mm_setr_epi32(0, 1, 2, 3));
+        __m128 fx = _mm_mul_ps(_mm_cvtepi32_ps(cells), _mm_set1_ps(row.frequency));
+        __m128i ix = _mm_cvttps_epi32(fx);
+        __m128 truncated = _mm_cvtepi32_ps(ix);
+        __m128 below = _mm_cmpgt_ps(truncated, fx);
+        ix = _mm_add_epi32(ix, _mm_castps_si128(below));
+        __m128 tx = _mm_sub_ps(fx, _mm_cvtepi32_ps(ix));
+        __m128 tx1 = _mm_sub_ps(tx, one);
+
+        int k[4];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(k), _mm_sub_epi32(ix, _mm_set1_epi32(row.column)));
+        __m128 g0x = _mm_setr_ps(row.row0X[k[0]], row.row0X[k[1]], row.row0X[k[2]], row.row0X[k[3]]);
+        __m128 g0y = _mm_setr_ps(row.row0Y[k[0]], row.row0Y[k[1]], row.row0Y[k[2]], row.row0Y[k[3]]);
+        __m128 g1x = _mm_setr_ps(row.row1X[k[0]], row.row1X[k[1]], row.row1X[k[2]], row.row1X[k[3]]);
+        __m128 g1y = _mm_setr_ps(row.row1Y[k[0]], row.row1Y[k[1]], row.row1Y[k[2]], row.row1Y[k[3]]);
+        __m128 h0x = _mm_setr_ps(row.row0X[k[0] + 1], row.row0X[k[1] + 1], row.row0X[k[2] + 1], row.row0X[k[3] + 1]);
+        __m128 h0y = _mm_setr_ps(row.row0Y[k[0] + 1], row.row0Y[k[1] + 1], row.row0Y[k[2] + 1], row.row0Y[k[3] + 1]);
+        __m128 h1x = _mm_setr_ps(row.row1X[k[0] + 1], row.row1X[k[1] + 1], row.row1X[k[2] + 1], row.row1X[k[3] + 1]);
+        __m128 h1y = _mm_setr_ps(row.row1Y[k[0] + 1], row.row1Y[k[1] + 1], row.row1Y[k[2] + 1], row.row1Y[k[3] + 1]);
+
+        __m128 n00 = _mm_add_ps(_mm_mul_ps(g0x, tx), _mm_mul_ps(g0y, ty));
+        __m128 n10 = _mm_add_ps(_mm_mul_ps(h0x, tx1), _mm_mul_ps(h0y, ty));
+        __m128 n01 = _mm_add_ps(_mm_mul_ps(g1x, tx), _mm_mul_ps(g1y, ty1));
+        __m128 n11 = _mm_add_ps(_mm_mul_ps(h1x, tx1), _mm_mul_ps(h1y, ty1));
+        __m128 u = fadeSse(tx);
+        __m128 value = lerpSse(lerpSse(n00, n10, u), lerpSse(n01, n11, u), _mm_set1_ps(row.v));
+        __m128 sum = _mm_add_ps(_mm_loadu_ps(out + i), _mm_mul_ps(_mm_set1_ps(row.amplitude), value));
+        _mm_storeu_ps(out + i, sum);
+    }
+    return i;
+}
+
+static int finishSse(int count, float scale, const float *in, int *out) {
+    const __m128 one = _mm_set1_ps(1);
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 value = _mm_max_ps(_mm_set1_ps(-1.0f), _mm_min_ps(one, _mm_mul_ps(_mm_loadu_ps(in + i), _mm_set1_ps(scale))));
+        __m128 rest = _mm_sub_ps(one, _mm_andnot_ps(sign, value));
+        __m128 pushed = _mm_sub_ps(one, _mm_mul_ps(rest, rest));
+        // The scalar path negates only below zero, so a negative zero stays positive here too
+        __m128 negative = _mm_cmplt_ps(value, _mm_setzero_ps());
+        value = _mm_or_ps(pushed, _mm_and_ps(negative, sign));
+        __m128 scaled = _mm_mul_ps(_mm_mul_ps(_mm_add_ps(value, one), _mm_set1_ps(0.5f)), _mm_set1_ps(253));
+        __m128i result = _mm_add_epi32(_mm_cvttps_epi32(scaled), _mm_set1_epi32(1));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), result);
+    }
+    return i;
+}
+
+[[gnu::always_inline]] __attribute__((target("avx2"))) static inline __m256 fadeAvx(__m256 t) {
+    __m256 inner = _mm256_add_ps(_mm256_mul_ps(t, _mm256_sub_ps(_mm256_mul_ps(t, _mm256_set1_ps(6)), _mm256_set1_ps(15))), _mm256_set1_ps(10));
+    return _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(t, t), t), inner);
+}
+
+[[gnu::always_inline]] __attribute__((target("avx2"))) static inline __m256 lerpAvx(__m256 a, __m256 b, __m256 t) {
+    return _mm256_add_ps(a, _mm256_mul_ps(t, _mm256_sub_ps(b, a)));
+}
+
+// Eight cells at a time, the lattice columns come in with gathers
+__attribute__((target("avx2"))) static int octaveAvx(const OctaveRow& row, int count, float *out) {
+    const __m256 one = _mm256_set1_ps(1);
+    const __m256 ty = _mm256_set1_ps(row.ty);
+    const __m256 ty1 = _mm256_set1_ps(row.ty - 1);
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i cells = _mm256_add_epi32(_mm256_set1_epi32(row.first + i), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+        __m256 fx = _mm256_mul_ps(_mm256_cvtepi32_ps(cells), _mm256_set1_ps(row.frequency));
+        __m256 floored = _mm256_floor_ps(fx);
+        __m256i ix = _mm256_cvttps_epi32(floored);
+        __m256 tx = _mm256_sub_ps(fx, floored);
+        __m256 tx1 = _mm256_sub_ps(tx, one);
+        __m256i k = _mm256_sub_epi32(ix, _mm256_set1_epi32(row.column));
+
+        __m256 g0x = _mm256_i32gather_ps(row.row0X, k, 4);
+        __m256 g0y = _mm256_i32gather_ps(row.row0Y, k, 4);
+        __m256 g1x = _mm256_i32gather_ps(row.row1X, k, 4);
+        __m256 g1y = _mm256_i32gather_ps(row.row1Y, k, 4);
+        __m256 h0x = _mm256_i32gather_ps(row.row0X + 1, k, 4);
+        __m256 h0y = _mm256_i32gather_ps(row.row0Y + 1, k, 4);
+        __m256 h1x = _mm256_i32gather_ps(row.row1X + 1, k, 4);
+        __m256 h1y = _mm256_i32gather_ps(row.row1Y + 1, k, 4);
+
+        __m256 n00 = _mm256_add_ps(_mm256_mul_ps(g0x, tx), _mm256_mul_ps(g0y, ty));
+        __m256 n10 = _mm256_add_ps(_mm256_mul_ps(h0x, tx1), _mm256_mul_ps(h0y, ty));
+        __m256 n01 = _mm256_add_ps(_mm256_mul_ps(g1x, tx), _mm256_mul_ps(g1y, ty1));
+        __m256 n11 = _mm256_add_ps(_mm256_mul_ps(h1x, tx1), _mm256_mul_ps(h1y, ty1));
+        __m256 u = fadeAvx(tx);
+        __m256 value = lerpAvx(lerpAvx(n00, n10, u), lerpAvx(n01, n11, u), _mm256_set1_ps(row.v));
+        __m256 sum = _mm256_add_ps(_mm256_loadu_ps(out + i), _mm256_mul_ps(_mm256_set1_ps(row.amplitude), value));
+        _mm256_storeu_ps(out + i, sum);
+    }
+    return i;
+}
+
+__attribute__((target("avx2"))) static int finishAvx(int count, float scale, const float *in, int *out) {
+    const __m256 one = _mm256_set1_ps(1);
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 value = _mm256_max_ps(_mm256_set1_ps(-1.0f), _mm256_min_ps(one, _mm256_mul_ps(_mm256_loadu_ps(in + i), _mm256_set1_ps(scale))));
+        __m256 rest = _mm256_sub_ps(one, _mm256_andnot_ps(sign, value));
+        __m256 pushed = _mm256_sub_ps(one, _mm256_mul_ps(rest, rest));
+        __m256 negative = _mm256_cmp_ps(value, _mm256_setzero_ps(), _CMP_LT_OQ);
+        value = _mm256_or_ps(pushed, _mm256_and_ps(negative, sign));
+        __m256 scaled = _mm256_mul_ps(_mm256_mul_ps(_mm256_add_ps(value, one), _mm256_set1_ps(0.5f)), _mm256_set1_ps(253));
+        __m256i result = _mm256_add_epi32(_mm256_cvttps_epi32(scaled), _mm256_set1_epi32(1));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), result);
+    }
+    return i;
+}
+#endif
 
-    for (int i = 0; i < MAX_HEIGHT; i++) {
-        for (int j = 0; j < MAX_WIDTH; j++) {
-            float scale = 0.12;
-            float value = perlin(j * scale, i * scale);
+enum class NoisePath {
+    Scalar,
+    Sse,
+    Avx
+};
+
+static const char *pathNames[] = {"scalar", "sse2", "avx2"};
 
-            int sign = (value < 0) ? -1 : 1;
-            value = (1 - (1 - fabs(value)) * (1 - fabs(value))) * sign;
-            value = (int)(((value + 1.0) / 2.0) * 253) + 1;
-            dungeon[i][j].hardness = value;
+static NoisePath bestPath() {
+#ifdef PERLIN_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return NoisePath::Avx;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return NoisePath::Sse;
+    }
+#endif
+    return NoisePath::Scalar;
+}
+
+static NoisePath path = bestPath();
+
+std::vector<const char *> noisePaths() {
+    std::vector<const char *> names;
+    for (int p = 0; p <= static_cast<int>(bestPath()); p++) {
+        names.push_back(pathNames[p]);
+    }
+    return names;
+}
+
+bool useNoisePath(const char *name) {
+    for (int p = 0; p <= static_cast<int>(bestPath()); p++) {
+        if (!strcmp(name, pathNames[p])) {
+            path = static_cast<NoisePath>(p);
+            return true;
         }
     }
+    return false;
+}
+
+const char *noisePath() {
+    return pathNames[static_cast<int>(path)];
+}
+
+// Hardness for count cells of the world row worldY, starting at worldX
+static void hardnessRow(const NoiseTables& t, int worldX, int worldY, int count, int *out) {
+    noise.assign(count, 0.0f);
+    float frequency = BASE_FREQUENCY;
+    float amplitude = 1;
+    float amplitudes = 0;
+    for (int octave = 0; octave < HARDNESS_OCTAVES; octave++) {
+        OctaveRow row;
+        row.first = worldX;
+        row.frequency = frequency;
+        row.amplitude = amplitude;
+        float fy = (float)worldY * frequency;
+        int iy = (int)floorf(fy);
+        row.ty = fy - (float)iy;
+        row.v = fade(row.ty);
+
+        // One gradient pair per lattice column the row crosses, plus the column past the last cell
+        row.column = (int)floorf((float)worldX * frequency);
+        int columns = (int)floorf((float)(worldX + count - 1) * frequency) - row.column + 2;
+        LatticeColumns& cols = lattice[octave];
+        if (cols.iy != iy || cols.column != row.column || cols.columns != columns) {
+            bool next = cols.iy + 1 == iy && cols.column == row.column && cols.columns == columns;
+            if (next) {
+                std::swap(cols.row0X, cols.row1X);
+                std::swap(cols.row0Y, cols.row1Y);
+            }
+            cols.iy = iy;
+            cols.column = row.column;
+            cols.columns = columns;
+            cols.row0X.resize(columns);
+            cols.row0Y.resize(columns);
+            cols.row1X.resize(columns);
+            cols.row1Y.resize(columns);
+            float *row0X = cols.row0X.data();
+            float *row0Y = cols.row0Y.data();
+            float *row1X = cols.row1X.data();
+            float *row1Y = cols.row1Y.data();
+            for (int c = 0; c < columns; c++) {
+                if (!next) {
+                    int g0 = latticeHash(t, octave, row.column + c, iy);
+                    row0X[c] = t.gradX[g0];
+                    row0Y[c] = t.gradY[g0];
+                }
+                int g1 = latticeHash(t, octave, row.column + c, iy + 1);
+                row1X[c] = t.gradX[g1];
+                row1Y[c] = t.gradY[g1];
+            }
+        }
+        row.row0X = cols.row0X.data();
+        row.row0Y = cols.row0Y.data();
+        row.row1X = cols.row1X.data();
+        row.row1Y = cols.row1Y.data();
+
+        int done = 0;
+#ifdef PERLIN_X86
+        if (path == NoisePath::Avx) {
+            done = octaveAvx(row, count, noise.data());
+        }
+        else if (path == NoisePath::Sse) {
+            done = octaveSse(row, count, noise.data());
+        }
+#endif
+        octaveScalar(row, done, count, noise.data());
+
+        amplitudes += amplitude * amplitude;
+        frequency *= 2;
+        amplitude *= 0.5f;
+    }
+
+    // Keeps the spread of a single octave, the rare sums past 1 are clamped
+    float scale = 1 / sqrtf(amplitudes);
+    int done = 0;
+#ifdef PERLIN_X86
+    if (path == NoisePath::Avx) {
+        done = finishAvx(count, scale, noise.data(), out);
+    }
+    else if (path == NoisePath::Sse) {
+        done = finishSse(count, scale, noise.data(), out);
+    }
+#endif
+    finishScalar(done, count, scale, noise.data(), out);
+}
+
+void generateHardnessAt(unsigned int seed, int worldX, int worldY, int x, int y, int width, int height) {
+    TraceSpan span("generateHardness", "generation");
+    const NoiseTables& t = tablesFor(seed);
+    for (LatticeColumns& cols : lattice) {
+        cols.iy = INT_MIN;
+    }
+    hardness.resize(width);
+    int *values = hardness.data();
+    for (int i = 0; i < height; i++) {
+        hardnessRow(t, worldX, worldY + i, width, values);
+        Tile *cells = &dungeon[y + i][x];
+        for (int j = 0; j < width; j++) {
+            cells[j].hardness = values[j];
+        }
+    }
+}
+
+void generateHardness() {
+    // A single draw, so the rest of generation sees the same rand() sequence at any map size
+    generateHardnessAt(rand(), 0, 0, 0, 0, dungeonWidth, dungeonHeight);
 }
@@ -0,0 +1,101 @@
+#include <cstdio>
+
+#include "display.hpp"
+#include "dungeon.hpp"
+#include "entityArena.hpp"
+#include "globals.hpp"
+#include "profiler.hpp"
+#include "renderer.hpp"
+
+PhaseStats phaseTurn[PHASE_COUNT];
+long counterTurn[COUNTER_COUNT];
+bool statsOverlayToggle = false;
+
+static PhaseStats phaseLast[PHASE_COUNT];
+static PhaseStats phaseTotal[PHASE_COUNT];
+static int64_t phaseMax[PHASE_COUNT];
+static long counterLast[COUNTER_COUNT];
+static long counterTotal[COUNTER_COUNT];
+static long counterMax[COUNTER_COUNT];
+static long turns = 0;
+
+static const char *phaseNames[PHASE_COUNT] = {
+    "scheduler pop", "monster AI", "generateDistances", "checkCorridor", "FOV", "printDungeon", "refresh"
+};
+static const char *counterNames[COUNTER_COUNT] = {
+    "pathfinding calls", "distance fields built", "heap ops", "curses calls"
+};
+
+const char *phaseName(Phase phase) {
+    return phaseNames[static_cast<int>(phase)];
+}
+
+void endTurn() {
+    for (int i = 0; i < PHASE_COUNT; i++) {
+        phaseLast[i] = phaseTurn[i];
+        phaseTotal[i].calls += phaseTurn[i].calls;
+        phaseTotal[i].nanos += phaseTurn[i].nanos;
+        if (phaseTurn[i].nanos > phaseMax[i]) {
+            phaseMax[i] = phaseTurn[i].nanos;
+        }
+        phaseTurn[i] = PhaseStats();
+    }
+    for (int i = 0; i < COUNTER_COUNT; i++) {
+        counterLast[i] = counterTurn[i];
+        counterTotal[i] += counterTurn[i];
+        if (counterTurn[i] > counterMax[i]) {
+            counterMax[i] = counterTurn[i];
+        }
+        counterTurn[i] = 0;
+    }
+    turns++;
+}
+
+void toggleStatsOverlay() {
+    statsOverlayToggle = !statsOverlayToggle;
+    printDungeon();
+}
+
+static void drawStatsLine(int row, int left, int width, const char *text, Color color) {
+    int end = renderer->drawText(row, left, text, color);
+    for (; end < left + width; end++) {
+        renderer->drawChar(row, end, ' ', Color::Default);
+    }
+}
+
+// Last completed turn, boxed into the top right corner of the map
+void drawStatsOverlay() {
+    static const int width = 36;
+    int left = VIEW_WIDTH - width;
+    int row = 1;
+    char line[width + 1];
+
+    snprintf(line, sizeof(line), " turn %-8ld       us  calls", turns);
+    drawStatsLine(row++, left, width, line, supportsColor ? Color::Cyan : Color::Default);
+    for (int i = 0; i < PHASE_COUNT; i++) {
+        snprintf(line, sizeof(line), " %-18s %7.1f %5ld ", phaseNames[i], phaseLast[i].nanos / 1000.0, phaseLast[i].calls);
+        drawStatsLine(row++, left, width, line, Color::Default);
+    }
+    for (int i = 0; i < COUNTER_COUNT; i++) {
+        snprintf(line, sizeof(line), " %-22s %9ld  ", counterNames[i], counterLast[i]);
+        drawStatsLine(row++, left, width, line, Color::Default);
+    }
+}
+
+void printStats() {
+    if (turns == 0) {
+        return;
+    }
+
+    printf("Turns: %ld\n\n", turns);
+    printf("%-22s %10s %12s %12s %12s\n", "phase", "calls", "total ms", "avg us/turn", "max us/turn");
+    for (int i = 0; i < PHASE_COUNT; i++) {
+        printf("%-22s %10ld %12.2f %12.2f %12.2f\n", phaseNames[i], phaseTotal[i].calls, phaseTotal[i].nanos / 1e6,
+               phaseTotal[i].nanos / 1e3 / turns, phaseMax[i] / 1e3);
+    }
+    printf("\n%-22s %10s %12s %12s\n", "counter", "total", "avg/turn", "max/turn");
+    for (int i = 0; i < COUNTER_COUNT; i++) {
+        printf("%-22s %10ld %12.2f %12ld\n", counterNames[i], counterTotal[i], static_cast<double>(counterTotal[i]) / turns, counterMax[i]);
+    }
+    printArenaStats();
+}
@@ -0,0 +1,110 @@
+#include "prototype.hpp"
+
+static const struct {
+    const char *name;
+    Color color;
+} colorNames[] = {
+    {"BLACK", Color::Black},
+    {"RED", Color::Red},
+    {"GREEN", Color::Green},
+    {"YELLOW", Color::Yellow},
+    {"BLUE", Color::Blue},
+    {"MAGENTA", Color::Magenta},
+    {"CYAN", Color::Cyan},
+    {"WHITE", Color::White}
+};
+
+static const struct {
+    const char *name;
+    unsigned int bit;
+} abilityNames[] = {
+    {"SMART", ABIL_SMART},
+    {"TELE", ABIL_TELE},
+    {"TUNNEL", ABIL_TUNNEL},
+    {"ERRATIC", ABIL_ERRATIC},
+    {"PASS", ABIL_PASS},
+    {"PICKUP", ABIL_PICKUP},
+    {"DESTROY", ABIL_DESTROY},
+    {"UNIQ", ABIL_UNIQ},
+    {"BOSS", ABIL_BOSS}
+};
+
+static const struct {
+    const char *name;
+    ObjectKind kind;
+    char symbol;
+    Equip equip;
+    const char *typeString;
+} kindNames[] = {
+    {"WEAPON", ObjectKind::Weapon, '|', Equip::Weapon, "Weapon"},
+    {"OFFHAND", ObjectKind::Offhand, ')', Equip::Offhand, "Offhand"},
+    {"RANGED", ObjectKind::Ranged, '}', Equip::Ranged, "Ranged"},
+    {"ARMOR", ObjectKind::Armor, '[', Equip::Armor, "Armor"},
+    {"HELMET", ObjectKind::Helmet, ']', Equip::Helmet, "Helmet"},
+    {"CLOAK", ObjectKind::Cloak, '(', Equip::Cloak, "Cloak"},
+    {"GLOVES", ObjectKind::Gloves, '{', Equip::Gloves, "Gloves"},
+    {"BOOTS", ObjectKind::Boots, '\\', Equip::Boots, "Boots"},
+    {"RING", ObjectKind::Ring, '=', Equip::Ring1, "Ring"},
+    {"AMULET", ObjectKind::Amulet, '"', Equip::Amulet, "Ring"},
+    {"LIGHT", ObjectKind::Light, '_', Equip::Light, "Light"},
+    {"SCROLL", ObjectKind::Scroll, '~', Equip::None, "Scroll"},
+    {"BOOK", ObjectKind::Book, '?', Equip::None, "Book"},
+    {"FLASK", ObjectKind::Flask, '!', Equip::None, "Flask"},
+    {"GOLD", ObjectKind::Gold, '$', Equip::None, "Gold"},
+    {"AMMUNITION", ObjectKind::Ammunition, '/', Equip::None, "Ammunition"},
+    {"FOOD", ObjectKind::Food, ',', Equip::None, "Food"},
+    {"WAND", ObjectKind::Wand, '-', Equip::None, "Wand"},
+    {"CONTAINER", ObjectKind::Container, '%', Equip::None, "Container"}
+};
+
+std::vector<Color> compileColors(const std::vector<std::string>& names) {
+    std::vector<Color> colors;
+    for (const std::string& name : names) {
+        for (const auto& entry : colorNames) {
+            if (name == entry.name) {
+                colors.push_back(entry.color);
+                break;
+            }
+        }
+    }
+    return colors;
+}
+
+unsigned int compileAbilities(const std::vector<std::string>& names) {
+    unsigned int abilities = 0;
+    for (const std::string& name : names) {
+        for (const auto& entry : abilityNames) {
+            if (name == entry.name) {
+                abilities |= entry.bit;
+                break;
+            }
+        }
+    }
+    return abilities;
+}
+
+ObjectPrototype compileObjectTypes(const std::vector<std::string>& types, const std::vector<std::string>& colors) {
+    ObjectPrototype proto;
+    proto.colors = compileColors(colors);
+    if (types.empty()) {
+        return proto;
+    }
+
+    for (const auto& entry : kindNames) {
+        if (types.front() == entry.name) {
+            proto.kind = entry.kind;
+            proto.symbol = entry.symbol;
+            proto.equip = entry.equip;
+            proto.typeString = entry.typeString;
+            break;
+        }
+    }
+    // Two types is a two-handed weapon, whatever the first one says
+    if (types.size() == 2) {
+        proto.twoHanded = true;
+        proto.symbol = ')';
+        proto.equip = Equip::Weapon;
+        proto.typeString = "Weapon";
+    }
+    return proto;
+}
@@ -0,0 +1,341 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <iostream>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "recorder.hpp"
+#include "renderer.hpp"
+#include "trace.hpp"
+
+std::unique_ptr<Recorder> recorder;
+
+static std::string recorderSocketPath;
+static const auto recordingStart = std::chrono::steady_clock::now();
+
+FrameRing::FrameRing() : buffer(new char[RING_CAPACITY]), head(0), tail(0) {}
+
+void FrameRing::copyIn(size_t at, const void *src, size_t len) {
+    size_t pos = at & (RING_CAPACITY - 1);
+    size_t first = std::min(len, RING_CAPACITY - pos);
+    memcpy(buffer.get() + pos, src, first);
+    memcpy(buffer.get(), static_cast<const char *>(src) + first, len - first);
+}
+
+void FrameRing::copyOut(size_t at, void *dst, size_t len) {
+    size_t pos = at & (RING_CAPACITY - 1);
+    size_t first = std::min(len, RING_CAPACITY - pos);
+    memcpy(dst, buffer.get() + pos, first);
+    memcpy(static_cast<char *>(dst) + first, buffer.get(), len - first);
+}
+
+bool FrameRing::push(double time, const char *data, uint32_t len) {
+    size_t h = head.load(std::memory_order_relaxed);
+    size_t t = tail.load(std::memory_order_acquire);
+    size_t need = sizeof(len) + sizeof(time) + len;
+    if (RING_CAPACITY - (h - t) < need) {
+        return false;
+    }
+
+    copyIn(h, &len, sizeof(len));
+    copyIn(h + sizeof(len), &time, sizeof(time));
+    copyIn(h + sizeof(len) + sizeof(time), data, len);
+    head.store(h + need, std::memory_order_release);
+    return true;
+}
+
+bool FrameRing::pop(double& time, std::vector<char>& data) {
+    size_t t = tail.load(std::memory_order_relaxed);
+    size_t h = head.load(std::memory_order_acquire);
+    if (h == t) {
+        return false;
+    }
+
+    uint32_t len;
+    copyOut(t, &len, sizeof(len));
+    copyOut(t + sizeof(len), &time, sizeof(time));
+    data.resize(len);
+    copyOut(t + sizeof(len) + sizeof(time), data.data(), len);
+    tail.store(t + sizeof(len) + sizeof(time) + len, std::memory_order_release);
+    return true;
+}
+
+static std::string castHeader() {
+    const char *term = getenv("TERM") ? getenv("TERM") : "xterm-256color";
+    char header[256];
+    snprintf(header, sizeof(header), "{\"version\": 2, \"width\": %d, \"height\": %d, \"timestamp\": %ld, \"env\": {\"TERM\": \"%s\"}}\n",
+             SCREEN_COLS, SCREEN_ROWS, static_cast<long>(time(nullptr)), term);
+    return header;
+}
+
+Recorder::Recorder(int fileFd, int listenFd) : fileFd(fileFd), listenFd(listenFd), running(true), keyframeRequested(false), framesDropped(0) {
+    if (fileFd != -1) {
+        std::string header = castHeader();
+        sendAll(fileFd, header.data(), header.size(), false);
+    }
+    writer = std::thread(&Recorder::run, this);
+}
+
+Recorder::~Recorder() {
+    stop();
+}
+
+void Recorder::recordFrame(double time, const char *data, size_t len) {
+    if (!ring.push(time, data, len)) {
+        // The stream is missing a diff now, so the next frame has to repaint everything
+        framesDropped++;
+        keyframeRequested = true;
+    }
+}
+
+bool Recorder::takeKeyframeRequest() {
+    return keyframeRequested.exchange(false);
+}
+
+void Recorder::stop() {
+    if (!running) {
+        return;
+    }
+    running = false;
+    writer.join();
+
+    for (int fd : clients) {
+        close(fd);
+    }
+    clients.clear();
+    if (listenFd != -1) {
+        close(listenFd);
+    }
+    if (fileFd != -1) {
+        close(fileFd);
+    }
+}
+
+void Recorder::run() {
+    nameTraceThread("recorder");
+    double time;
+    std::vector<char> data;
+    while (true) {
+        if (listenFd != -1) {
+            acceptClients();
+        }
+        if (ring.pop(time, data)) {
+            sendEvent(time, data);
+        }
+        else if (!running) {
+            return;
+        }
+        else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+}
+
+void Recorder::acceptClients() {
+    int fd;
+    while ((fd = accept(listenFd, nullptr, nullptr)) != -1) {
+        std::string header = castHeader();
+        clients.push_back(fd);
+        sendAll(fd, header.data(), header.size(), true);
+
+        // Spectators join mid-session, start them from a blank screen and a full frame
+        std::vector<char> clearScreen = {'\x1b', '[', '2', 'J'};
+        std::chrono::duration<double> now = std::chrono::steady_clock::now() - recordingStart;
+        sendEvent(now.count(), clearScreen);
+        keyframeRequested = true;
+    }
+}
+
+void Recorder::sendEvent(double time, const std::vector<char>& data) {
+    TraceSpan span("send frame", "recorder");
+    std::string event;
+    event.reserve(data.size() * 2 + 32);
+
+    char prefix[32];
+    snprintf(prefix, sizeof(prefix), "[%.6f, \"o\", \"", time);
+    event += prefix;
+    for (char c : data) {
+        if (c == '"' || c == '\\') {
+            event += '\\';
+            event += c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20) {
+            char escape[8];
+            snprintf(escape, sizeof(escape), "\\u%04x", c);
+            event += escape;
+        }
+        else {
+            event += c;
+        }
+    }
+    event += "\"]\n";
+
+    if (fileFd != -1) {
+        sendAll(fileFd, event.data(), event.size(), false);
+    }
+    for (size_t i = 0; i < clients.size(); i++) {
+        sendAll(clients[i], event.data(), event.size(), true);
+    }
+    clients.erase(std::remove(clients.begin(), clients.end(), -1), clients.end());
+}
+
+void Recorder::sendAll(int fd, const char *data, size_t len, bool isClient) {
+    while (len > 0) {
+        ssize_t n;
+        if (isClient) {
+            n = send(fd, data, len, MSG_DONTWAIT | MSG_NOSIGNAL);
+        }
+        else {
+            n = write(fd, data, len);
+        }
+
+        if (n <= 0) {
+            if (isClient) {
+                // A spectator that cannot keep up is dropped rather than allowed to stall the recording
+                close(fd);
+                std::replace(clients.begin(), clients.end(), fd, -1);
+            }
+            return;
+        }
+        data += n;
+        len -= n;
+    }
+}
+
+bool startRecording(const char *filename, const char *socketPath) {
+    int fileFd = -1;
+    int listenFd = -1;
+
+    if (filename != nullptr) {
+        fileFd = open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fileFd == -1) {
+            std::cout << "Error: Cannot open recording file " << filename << std::endl;
+            return false;
+        }
+    }
+
+    if (socketPath != nullptr) {
+        sockaddr_un addr = {};
+        addr.sun_family = AF_UNIX;
+        strncpy(addr.sun_path, socketPath, sizeof(addr.sun_path) - 1);
+
+        unlink(socketPath);
+        listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
+        if (listenFd == -1 || bind(listenFd, (sockaddr *)&addr, sizeof(addr)) != 0 || listen(listenFd, 8) != 0) {
+            std::cout << "Error: Cannot listen on socket " << socketPath << std::endl;
+            if (fileFd != -1) {
+                close(fileFd);
+            }
+            if (listenFd != -1) {
+                close(listenFd);
+            }
+            return false;
+        }
+        recorderSocketPath = socketPath;
+    }
+
+    recorder = std::make_unique<Recorder>(fileFd, listenFd);
+    return true;
+}
+
+void recordFrame(const char *data, size_t len) {
+    if (recorder) {
+        std::chrono::duration<double> now = std::chrono::steady_clock::now() - recordingStart;
+        recorder->recordFrame(now.count(), data, len);
+    }
+}
+
+void stopRecording() {
+    if (!recorder) {
+        return;
+    }
+
+    recorder->stop();
+    long dropped = recorder->framesDropped;
+    recorder = nullptr;
+    if (!recorderSocketPath.empty()) {
+        unlink(recorderSocketPath.c_str());
+    }
+    if (dropped > 0) {
+        std::cout << "Recording dropped " << dropped << " frames" << std::endl;
+    }
+}
+
+// Pulls the output string out of one asciicast event line and writes it to the terminal
+static void playEvent(const std::string& line) {
+    size_t start = line.find("\"o\", \"");
+    if (line.empty() || line[0] != '[' || start == std::string::npos) {
+        return;
+    }
+
+    std::string out;
+    for (size_t i = start + 6; i < line.size() && line[i] != '"'; i++) {
+        if (line[i] != '\\' || i + 1 >= line.size()) {
+            out += line[i];
+            continue;
+        }
+
+        i++;
+        switch (line[i]) {
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'u':
+                if (i + 4 < line.size()) {
+                    out += static_cast<char>(strtol(line.substr(i + 1, 4).c_str(), nullptr, 16));
+                    i += 4;
+                }
+                break;
+            default: out += line[i]; break;
+        }
+    }
+
+    size_t written = 0;
+    while (written < out.size()) {
+        ssize_t n = write(STDOUT_FILENO, out.data() + written, out.size() - written);
+        if (n <= 0) {
+            return;
+        }
+        written += n;
+    }
+}
+
+int spectate(const char *socketPath) {
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, socketPath, sizeof(addr.sun_path) - 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd == -1 || connect(fd, (sockaddr *)&addr, sizeof(addr)) != 0) {
+        std::cout << "Error: Cannot connect to " << socketPath << std::endl;
+        return 1;
+    }
+
+    std::string pending;
+    char buf[1 << 16];
+    ssize_t n;
+    while ((n = read(fd, buf, sizeof(buf))) > 0) {
+        pending.append(buf, n);
+
+        size_t lineStart = 0;
+        size_t lineEnd;
+        while ((lineEnd = pending.find('\n', lineStart)) != std::string::npos) {
+            playEvent(pending.substr(lineStart, lineEnd - lineStart));
+            lineStart = lineEnd + 1;
+        }
+        pending.erase(0, lineStart);
+    }
+    close(fd);
+
+    printf("\x1b[0m\x1b[%dH\nSession ended.\n", SCREEN_ROWS);
+    return 0;
+}
@@ -0,0 +1,389 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <linux/sockios.h>
+#include <ncurses.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+#include "display.hpp"
+#include "dungeon.hpp"
+#include "game.hpp"
+#include "globals.hpp"
+#include "latency.hpp"
+#include "profiler.hpp"
+#include "recorder.hpp"
+#include "renderer.hpp"
+
+std::unique_ptr<Renderer> renderer;
+Pos viewOrigin = {0, 0};
+
+static int clampOrigin(int origin, int viewSize, int dungeonSize) {
+    return std::max(0, std::min(origin, dungeonSize - viewSize));
+}
+
+bool scrollViewport(Pos focus) {
+    Pos origin = viewOrigin;
+    if (focus.x < origin.x + VIEW_MARGIN_X || focus.x >= origin.x + VIEW_WIDTH - VIEW_MARGIN_X) {
+        origin.x = focus.x - VIEW_WIDTH / 2;
+    }
+    if (focus.y < origin.y + VIEW_MARGIN_Y || focus.y >= origin.y + VIEW_HEIGHT - VIEW_MARGIN_Y) {
+        origin.y = focus.y - VIEW_HEIGHT / 2;
+    }
+    origin.x = clampOrigin(origin.x, VIEW_WIDTH, dungeonWidth);
+    origin.y = clampOrigin(origin.y, VIEW_HEIGHT, dungeonHeight);
+    if (origin == viewOrigin) {
+        return false;
+    }
+    viewOrigin = origin;
+    return true;
+}
+
+void Renderer::drawMapChar(int y, int x, char ch, Color color) {
+    y -= viewOrigin.y;
+    x -= viewOrigin.x;
+    if (y >= 0 && y < VIEW_HEIGHT && x >= 0 && x < VIEW_WIDTH) {
+        drawChar(y + 1, x, ch, color);
+    }
+}
+
+void NcursesRenderer::drawChar(int y, int x, char ch, Color color) {
+    countEvent(Counter::CursesCalls);
+    mvaddch(y, x, static_cast<unsigned char>(ch) | COLOR_PAIR(color));
+}
+
+int NcursesRenderer::drawText(int y, int x, const char *text, Color color) {
+    countEvent(Counter::CursesCalls, 3);
+    attron(COLOR_PAIR(color));
+    mvaddstr(y, x, text);
+    attroff(COLOR_PAIR(color));
+
+    int end = x + strlen(text);
+    return end < SCREEN_COLS ? end : SCREEN_COLS;
+}
+
+void NcursesRenderer::clearToEol(int y, int x) {
+    countEvent(Counter::CursesCalls, 2);
+    move(y, x);
+    clrtoeol();
+}
+
+void NcursesRenderer::present() {
+    PhaseProbe probe(Phase::Refresh);
+    countEvent(Counter::CursesCalls);
+    stats.presents++;
+    refresh();
+    frameCompleted();
+}
+
+AnsiRenderer::AnsiRenderer(int fd, bool hosted) : fd(fd), hosted(hosted) {
+    front.assign(SCREEN_ROWS * SCREEN_COLS, (Cell){'\0', Color::Default});
+    back.assign(SCREEN_ROWS * SCREEN_COLS, (Cell){' ', Color::Default});
+    out.reserve(SCREEN_ROWS * SCREEN_COLS * 4);
+}
+
+void AnsiRenderer::drawChar(int y, int x, char ch, Color color) {
+    if (y < 0 || y >= SCREEN_ROWS || x < 0 || x >= SCREEN_COLS) {
+        return;
+    }
+    back[y * SCREEN_COLS + x] = (Cell){ch, color};
+}
+
+int AnsiRenderer::drawText(int y, int x, const char *text, Color color) {
+    for (; *text != '\0' && x < SCREEN_COLS; text++, x++) {
+        drawChar(y, x, *text, color);
+    }
+    return x;
+}
+
+void AnsiRenderer::clearToEol(int y, int x) {
+    for (; x < SCREEN_COLS; x++) {
+        drawChar(y, x, ' ', Color::Default);
+    }
+}
+
+void AnsiRenderer::invalidate() {
+    for (Cell& cell : front) {
+        cell.ch = '\0';
+    }
+}
+
+// Shortest of absolute position, row-only position, column-only position or cursor forward
+void AnsiRenderer::appendMove(int y, int x, int curY, int curX, Color curColor) {
+    char best[16];
+    int bestLen = snprintf(best, sizeof(best), "\x1b[%d;%dH", y + 1, x + 1);
+
+    char candidate[16];
+    int len;
+    if (x == 0) {
+        len = snprintf(candidate, sizeof(candidate), "\x1b[%dH", y + 1);
+        if (len < bestLen) {
+            memcpy(best, candidate, len + 1);
+            bestLen = len;
+        }
+    }
+    if (y == curY) {
+        len = snprintf(candidate, sizeof(candidate), "\x1b[%dG", x + 1);
+        if (len < bestLen) {
+            memcpy(best, candidate, len + 1);
+            bestLen = len;
+        }
+        if (x > curX) {
+            int gap = x - curX;
+            len = snprintf(candidate, sizeof(candidate), "\x1b[%dC", gap);
+            if (len < bestLen) {
+                memcpy(best, candidate, len + 1);
+                bestLen = len;
+            }
+
+            // Reprinting a few unchanged cells beats any escape sequence when they share the current color
+            bool sameColor = gap < bestLen;
+            for (int i = curX; sameColor && i < x; i++) {
+                sameColor = back[y * SCREEN_COLS + i].color == curColor;
+            }
+            if (sameColor) {
+                for (int i = curX; i < x; i++) {
+                    out += back[y * SCREEN_COLS + i].ch;
+                }
+                return;
+            }
+        }
+    }
+    out.append(best, bestLen);
+}
+
+void AnsiRenderer::appendColor(Color color) {
+    static const int foreground[] = {0, 7, 1, 2, 3, 4, 5, 6, 7};
+
+    char sgr[16];
+    int len;
+    if (color == Color::Default) {
+        len = snprintf(sgr, sizeof(sgr), "\x1b[0m");
+    }
+    else {
+        len = snprintf(sgr, sizeof(sgr), "\x1b[3%d;40m", foreground[static_cast<int>(color)]);
+    }
+    out.append(sgr, len);
+}
+
+void AnsiRenderer::flush() {
+    size_t written = 0;
+    while (written < out.size()) {
+        ssize_t n = write(fd, out.data() + written, out.size() - written);
+        stats.writeCalls++;
+        if (n <= 0) {
+            break;
+        }
+        written += n;
+    }
+    stats.bytesWritten += written;
+    recordFrame(out.data(), written);
+}
+
+void AnsiRenderer::present() {
+    PhaseProbe probe(Phase::Refresh);
+    stats.presents++;
+    out.clear();
+    if (recorder && recorder->takeKeyframeRequest()) {
+        invalidate();
+    }
+
+    int stdY = 0, stdX = 0, curscrY = 0, curscrX = 0;
+    if (hosted) {
+        getyx(stdscr, stdY, stdX);
+        getyx(curscr, curscrY, curscrX);
+    }
+
+    int curY = -1;
+    int curX = -1;
+    Color curColor = Color::Default;
+    for (int y = 0; y < SCREEN_ROWS; y++) {
+        for (int x = 0; x < SCREEN_COLS; x++) {
+            int i = y * SCREEN_COLS + x;
+            if (back[i] == front[i]) {
+                continue;
+            }
+
+            if (y != curY || x != curX) {
+                appendMove(y, x, curY, curX, curColor);
+            }
+            if (back[i].color != curColor) {
+                appendColor(back[i].color);
+                curColor = back[i].color;
+            }
+            out += back[i].ch;
+            front[i] = back[i];
+            curY = y;
+            curX = x + 1;
+
+            if (hosted) {
+                // Keep ncurses' idea of the screen honest so its own windows and restores line up
+                chtype cell = static_cast<unsigned char>(back[i].ch) | COLOR_PAIR(back[i].color);
+                mvwaddch(stdscr, y, x, cell);
+                mvwaddch(curscr, y, x, cell);
+                countEvent(Counter::CursesCalls, 2);
+            }
+        }
+    }
+
+    if (curY == -1) {
+        frameCompleted();
+        return;
+    }
+    if (curColor != Color::Default) {
+        appendColor(Color::Default);
+    }
+    if (hosted) {
+        appendMove(curscrY, curscrX, -1, -1, Color::Default);
+        wmove(stdscr, stdY, stdX);
+        wmove(curscr, curscrY, curscrX);
+    }
+    flush();
+    frameCompleted();
+}
+
+static void drain(int fd) {
+    int pending = 0;
+    while (ioctl(fd, SIOCOUTQ, &pending) == 0 && pending > 0) {
+        std::this_thread::yield();
+    }
+}
+
+static void stepPlayer() {
+    int directions[8][2] = {
+        {-1, 1},  {0, 1},  {1, 1},
+        {-1, 0},           {1, 0},
+        {-1, -1}, {0, -1}, {1, -1}};
+
+    for (int i = 0; i < ATTEMPTS; i++) {
+        int dir = rand() % 8;
+        int x = player.getPos().x + directions[dir][0];
+        int y = player.getPos().y + directions[dir][1];
+        if (dungeon[y][x].hardness == 0 && !monsterAt[y][x]) {
+            player.setPos((Pos){x, y});
+            return;
+        }
+    }
+}
+
+int renderBenchmark(int frames) {
+    const char *termName = getenv("TERM") ? getenv("TERM") : "xterm-256color";
+    Pos start = player.getPos();
+
+    printf("Rendering %d frames per run (TERM=%s)\n", frames, termName);
+    printf("%-8s  %-4s  %12s  %12s  %12s\n", "backend", "fog", "bytes/frame", "writes/frame", "us/frame");
+
+    for (int backend = 0; backend < 2; backend++) {
+        for (int fog = 1; fog >= 0; fog--) {
+            int sv[2];
+            if (socketpair(AF_UNIX, SOCK_SEQPACKET, 0, sv) != 0) {
+                perror("socketpair");
+                return 1;
+            }
+
+            // One record per write() on a seqpacket socket, so the reader counts syscalls exactly
+            std::atomic<long> bytes(0);
+            std::atomic<long> writes(0);
+            std::thread reader([&]() {
+                char buf[1 << 16];
+                ssize_t n;
+                while ((n = recv(sv[1], buf, sizeof(buf), 0)) > 0) {
+                    bytes += n;
+                    writes++;
+                }
+            });
+
+            FILE *out = nullptr;
+            FILE *in = nullptr;
+            SCREEN *screen = nullptr;
+            if (backend == 0) {
+                out = fdopen(sv[0], "w");
+                in = fopen("/dev/null", "r");
+                screen = newterm(termName, out, in);
+                if (screen == nullptr) {
+                    fprintf(stderr, "Cannot open terminal type %s\n", termName);
+                    // Closing the writing end lets the reader see EOF before it is joined
+                    if (out != nullptr) {
+                        fclose(out);
+                    }
+                    else {
+                        close(sv[0]);
+                    }
+                    if (in != nullptr) {
+                        fclose(in);
+                    }
+                    reader.join();
+                    close(sv[1]);
+                    return 1;
+                }
+                set_term(screen);
+                supportsColor = false;
+                if (has_colors()) {
+                    start_color();
+                    supportsColor = true;
+                    initColorPairs();
+                }
+                curs_set(0);
+                renderer = std::make_unique<NcursesRenderer>();
+            }
+            else {
+                supportsColor = true;
+                renderer = std::make_unique<AnsiRenderer>(sv[0], false);
+            }
+
+            fogOfWarToggle = fog;
+            player.setPos(start);
+            for (int i = 0; i < dungeonHeight; i++) {
+                for (int j = 0; j < dungeonWidth; j++) {
+                    dungeon[i][j].visible = FOG;
+                }
+            }
+            srand(frames);
+
+            // The first frame paints the whole screen, only steady state frames are measured
+            updateAroundPlayer();
+            printDungeon();
+            drain(sv[0]);
+            long startBytes = bytes;
+            long startWrites = writes;
+
+            auto begin = std::chrono::steady_clock::now();
+            for (int f = 0; f < frames; f++) {
+                stepPlayer();
+                animationTick++;
+                updateAroundPlayer();
+                printDungeon();
+            }
+            auto end = std::chrono::steady_clock::now();
+            drain(sv[0]);
+            long frameBytes = bytes - startBytes;
+            long frameWrites = writes - startWrites;
+
+            const char *name = renderer->getName();
+            renderer = nullptr;
+            if (backend == 0) {
+                endwin();
+                delscreen(screen);
+                fclose(out);
+                fclose(in);
+            }
+            else {
+                close(sv[0]);
+            }
+            reader.join();
+            close(sv[1]);
+
+            double micros = std::chrono::duration<double, std::micro>(end - begin).count();
+            printf("%-8s  %-4s  %12.1f  %12.2f  %12.2f\n", name, fog ? "on" : "off",
+                   static_cast<double>(frameBytes) / frames, static_cast<double>(frameWrites) / frames, micros / frames);
+        }
+    }
+
+    player.setPos(start);
+    return 0;
+}
@@ -5,6 +5,8 @@
 #include <string>
 
 #include "dungeon.hpp"
+#include "pathFinding.hpp"
+#include "trace.hpp"
 
 std::string dungeonFile;
 
@@ -13,7 +15,36 @@ int  setupDungeonFile(char *filename) {
     return 0 ;
 }
 
+// Version 0 is the original 80x21 format with byte coordinates, version 1 adds the dimensions after
+// the size field and widens every coordinate to 16 bits. Version 2 is version 1 followed by the type
+// of every cell, for levels such as caves whose open floor outside rooms would load back as corridor
+static const uint32_t SIZED_VERSION = 1;
+static const uint32_t TYPED_VERSION = 2;
+
+static int readCoord(FILE *file, bool wide) {
+    if (wide) {
+        uint16_t value = 0;
+        fread(&value, 2, 1, file);
+        return be16toh(value);
+    }
+    uint8_t value = 0;
+    fread(&value, 1, 1, file);
+    return value;
+}
+
+static void writeCoord(FILE *file, int value, bool wide) {
+    if (wide) {
+        uint16_t wideValue = htobe16(value);
+        fwrite(&wideValue, 2, 1, file);
+    }
+    else {
+        uint8_t narrowValue = value;
+        fwrite(&narrowValue, 1, 1, file);
+    }
+}
+
 int loadDungeon(char *filename) {
+    TraceSpan span("loadDungeon", "io");
     setupDungeonFile(filename);
     FILE *file = fopen(dungeonFile.c_str(), "r");
 
@@ -28,13 +59,25 @@ int loadDungeon(char *filename) {
     fread(&size, 4, 1, file);
     size = be32toh(size);
 
-    uint8_t pos[2];
-    fread(pos, 2, 1, file);
-    player.setPos((Pos){(int)pos[0], (int)pos[1]});
+    bool wide = version >= SIZED_VERSION;
+    int width = DEFAULT_WIDTH;
+    int height = DEFAULT_HEIGHT;
+    if (wide) {
+        width = readCoord(file, true);
+        height = readCoord(file, true);
+    }
+    if (width != dungeonWidth || height != dungeonHeight) {
+        resizeDungeon(width, height);
+    }
+
+    int playerX = readCoord(file, wide);
+    int playerY = readCoord(file, wide);
+    player.setPos((Pos){playerX, playerY});
 
-    for (int i = 0; i < MAX_HEIGHT; i++) {
-        for (int j = 0; j < MAX_WIDTH; j++) {
+    for (int i = 0; i < dungeonHeight; i++) {
+        for (int j = 0; j < dungeonWidth; j++) {
             fread(&dungeon[i][j].hardness, 1, 1, file);
+            dungeon[i][j].visible = FOG;
             if (dungeon[i][j].hardness == 0) {
                 dungeon[i][j].type = CORRIDOR;
             }
@@ -51,13 +94,12 @@ int loadDungeon(char *filename) {
 
     rooms.reserve(r);
     for (int i = 0; i < r; i++) {
-        uint8_t x, y, width, height;
-        fread(&x, 1, 1, file);
-        fread(&y, 1, 1, file);
-        fread(&width, 1, 1, file);
-        fread(&height, 1, 1, file);
+        int x = readCoord(file, wide);
+        int y = readCoord(file, wide);
+        int roomWidth = readCoord(file, wide);
+        int roomHeight = readCoord(file, wide);
 
-        rooms.emplace_back(Room((Pos){(int)x, (int)y}, (int)width, (int)height));
+        rooms.emplace_back(Room((Pos){x, y}, roomWidth, roomHeight));
         for (int j = rooms.back().getPos().y; j < rooms.back().getPos().y + rooms.back().getHeight(); j++) {
             for (int k = rooms.back().getPos().x; k < rooms.back().getPos().x + rooms.back().getWidth(); k++) {
                 dungeon[j][k].type = FLOOR;
@@ -71,11 +113,10 @@ int loadDungeon(char *filename) {
     upStairsCount = u;
 
     for (int i = 0; i < u; i++) {
-        uint8_t x, y;
-        fread(&x, 1, 1, file);
-        fread(&y, 1, 1, file);
-        upStairs.emplace_back((Pos){(int)x, (int)y});
-        dungeon[(int)y][(int)x].type = STAIR_UP;
+        int x = readCoord(file, wide);
+        int y = readCoord(file, wide);
+        upStairs.emplace_back((Pos){x, y});
+        dungeon[y][x].type = STAIR_UP;
     }
 
     uint16_t d;
@@ -84,35 +125,85 @@ int loadDungeon(char *filename) {
     downStairsCount = d;
 
     for (int i = 0; i < d; i++) {
-        uint8_t x, y;
-        fread(&x, 1, 1, file);
-        fread(&y, 1, 1, file);
-        downStairs.emplace_back((Pos){(int)x, (int)y});
-        dungeon[(int)y][(int)x].type = STAIR_DOWN;
+        int x = readCoord(file, wide);
+        int y = readCoord(file, wide);
+        downStairs.emplace_back((Pos){x, y});
+        dungeon[y][x].type = STAIR_DOWN;
     }
 
+    if (version >= TYPED_VERSION) {
+        for (int i = 0; i < dungeonHeight; i++) {
+            for (int j = 0; j < dungeonWidth; j++) {
+                fread(&dungeon[i][j].type, 1, 1, file);
+            }
+        }
+    }
+
+    terrainVersion++;
     std::cout << "Dungeon loaded from" << dungeonFile << std::endl;
     fclose(file);
     return 0;
 }
 
-int saveDungeon(char *filename) {
-    setupDungeonFile(filename);
-    FILE *file = fopen(dungeonFile.c_str(), "w");
+// Whether the types loadDungeon works out from hardness, rooms and stairs are the level's own
+static bool typesImplied() {
+    Grid<char> implied(dungeonWidth, dungeonHeight);
+    for (int i = 0; i < dungeonHeight; i++) {
+        for (int j = 0; j < dungeonWidth; j++) {
+            implied[i][j] = dungeon[i][j].hardness == 0 ? CORRIDOR : ROCK;
+        }
+    }
+    for (int r = 0; r < roomCount; r++) {
+        for (int i = rooms[r].getPos().y; i < rooms[r].getPos().y + rooms[r].getHeight(); i++) {
+            for (int j = rooms[r].getPos().x; j < rooms[r].getPos().x + rooms[r].getWidth(); j++) {
+                implied[i][j] = FLOOR;
+            }
+        }
+    }
+    for (int i = 0; i < upStairsCount; i++) {
+        implied[upStairs[i].y][upStairs[i].x] = STAIR_UP;
+    }
+    for (int i = 0; i < downStairsCount; i++) {
+        implied[downStairs[i].y][downStairs[i].x] = STAIR_DOWN;
+    }
+
+    for (int i = 0; i < dungeonHeight; i++) {
+        for (int j = 0; j < dungeonWidth; j++) {
+            if (implied[i][j] != dungeon[i][j].type) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int writeDungeon(const char *path) {
+    TraceSpan span("saveDungeon", "io");
+    FILE *file = fopen(path, "w");
+    if (file == nullptr) {
+        return 1;
+    }
 
     fwrite("RLG327-S2025", 1, 12, file);
 
-    uint32_t version = htobe32(0);
+    // Default sized levels keep the original format so other readers can still load them
+    bool typed = !typesImplied();
+    bool wide = typed || dungeonWidth != DEFAULT_WIDTH || dungeonHeight != DEFAULT_HEIGHT;
+    uint32_t version = htobe32(typed ? TYPED_VERSION : wide ? SIZED_VERSION : 0);
     fwrite(&version, 4, 1, file);
 
     uint32_t size = htobe32(sizeof(1712 + roomCount * 4));
     fwrite(&size, 4, 1, file);
 
-    uint8_t pos[2] = {(uint8_t) player.getPos().x, (uint8_t) player.getPos().y};
-    fwrite(pos, 2, 1, file);
+    if (wide) {
+        writeCoord(file, dungeonWidth, true);
+        writeCoord(file, dungeonHeight, true);
+    }
+    writeCoord(file, player.getPos().x, wide);
+    writeCoord(file, player.getPos().y, wide);
 
-    for (int i = 0; i < MAX_HEIGHT; i++) {
-        for (int j = 0; j < MAX_WIDTH; j++) {
+    for (int i = 0; i < dungeonHeight; i++) {
+        for (int j = 0; j < dungeonWidth; j++) {
             fwrite(&dungeon[i][j].hardness, 1, 1, file);
         }
     }
@@ -121,32 +212,46 @@ int saveDungeon(char *filename) {
     fwrite(&r, 2, 1, file);
 
     for (int i = 0; i < roomCount; i++) {
-        uint8_t room[4] = {
-            static_cast<uint8_t>(rooms[i].getPos().x),
-            static_cast<uint8_t>(rooms[i].getPos().y),
-            static_cast<uint8_t>(rooms[i].getWidth()),
-            static_cast<uint8_t>(rooms[i].getHeight())
-        };
-        fwrite(room, 4, 1, file);
+        writeCoord(file, rooms[i].getPos().x, wide);
+        writeCoord(file, rooms[i].getPos().y, wide);
+        writeCoord(file, rooms[i].getWidth(), wide);
+        writeCoord(file, rooms[i].getHeight(), wide);
     }
 
     uint16_t u = htobe16(upStairsCount);
     fwrite(&u, 2, 1, file);
 
     for (int i = 0; i < upStairsCount; i++) {
-        uint8_t upStairsPos[2] = {static_cast<uint8_t>(upStairs[i].x), static_cast<uint8_t>(upStairs[i].y)};
-        fwrite(upStairsPos, 2, 1, file);
+        writeCoord(file, upStairs[i].x, wide);
+        writeCoord(file, upStairs[i].y, wide);
     }
 
     uint16_t d = htobe16(downStairsCount);
     fwrite(&d, 2, 1, file);
 
     for (int i = 0; i < downStairsCount; i++) {
-        uint8_t downStairsPos[2] = {static_cast<uint8_t>(downStairs[i].x), static_cast<uint8_t>(downStairs[i].y)};
-        fwrite(downStairsPos, 2, 1, file);
+        writeCoord(file, downStairs[i].x, wide);
+        writeCoord(file, downStairs[i].y, wide);
+    }
+
+    if (typed) {
+        for (int i = 0; i < dungeonHeight; i++) {
+            for (int j = 0; j < dungeonWidth; j++) {
+                fwrite(&dungeon[i][j].type, 1, 1, file);
+            }
+        }
     }
 
-    std::cout << "Dungeon saved to" << dungeonFile << std::endl;
     fclose(file);
     return 0;
 }
+
+int saveDungeon(char *filename) {
+    setupDungeonFile(filename);
+    if (writeDungeon(dungeonFile.c_str())) {
+        std::cout << "Error: Cannot write " << dungeonFile << std::endl;
+        return 1;
+    }
+    std::cout << "Dungeon saved to" << dungeonFile << std::endl;
+    return 0;
+}
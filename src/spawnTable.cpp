@@ -0,0 +1,166 @@
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#include "parser.hpp"
+#include "spawnTable.hpp"
+#include "trace.hpp"
+
+// Vose's alias method: column i keeps itself with probability keep[i], otherwise gives alias[i].
+// Types that leave the pool stay in the table and are skipped when picked, until they hold half the
+// weight and the table is rebuilt, so a pick takes two tries at most on average
+class AliasTable {
+public:
+    bool dirty = true;
+    size_t types = 0;
+    long long total = 0;
+    long long removed = 0;
+    std::vector<int> entries;
+    std::vector<double> keep;
+    std::vector<int> alias;
+
+    void build(const std::vector<int>& indices, const std::vector<int>& weights);
+    int pick() const;
+};
+
+static AliasTable monsterTable;
+static AliasTable objectTable;
+
+void AliasTable::build(const std::vector<int>& indices, const std::vector<int>& weights) {
+    TraceSpan span("build alias table", "generation");
+    entries = indices;
+    int n = entries.size();
+    keep.assign(n, 0.0);
+    alias.assign(n, 0);
+    dirty = false;
+    total = 0;
+    removed = 0;
+    if (n == 0) {
+        return;
+    }
+
+    for (int weight : weights) {
+        total += weight;
+    }
+    std::vector<double> scaled(n);
+    std::vector<int> small, large;
+    for (int i = 0; i < n; i++) {
+        scaled[i] = static_cast<double>(weights[i]) * n / total;
+        if (scaled[i] < 1.0) {
+            small.push_back(i);
+        }
+        else {
+            large.push_back(i);
+        }
+    }
+    while (!small.empty() && !large.empty()) {
+        int less = small.back();
+        small.pop_back();
+        int more = large.back();
+        large.pop_back();
+
+        keep[less] = scaled[less];
+        alias[less] = more;
+        scaled[more] = (scaled[more] + scaled[less]) - 1.0;
+        if (scaled[more] < 1.0) {
+            small.push_back(more);
+        }
+        else {
+            large.push_back(more);
+        }
+    }
+    // Whatever is left is 1 up to rounding
+    for (int i : large) {
+        keep[i] = 1.0;
+    }
+    for (int i : small) {
+        keep[i] = 1.0;
+    }
+}
+
+int AliasTable::pick() const {
+    if (entries.empty()) {
+        return -1;
+    }
+    int column = rand() % entries.size();
+    double coin = static_cast<double>(rand()) / (static_cast<double>(RAND_MAX) + 1.0);
+    return entries[coin < keep[column] ? column : alias[column]];
+}
+
+static int monsterWeight(const MonsterType& type) {
+    // A monster passed when 1 + rand() % 100 came in under its rarity
+    return type.valid ? std::min(std::max(type.rarity - 1, 0), 100) : 0;
+}
+
+static int objectWeight(const ObjectType& type) {
+    // An object passed when rand() % 100 came in under its rarity
+    return type.valid ? std::min(std::max(type.rarity, 0), 100) : 0;
+}
+
+int pickMonsterType() {
+    if (monsterTable.dirty || monsterTable.types != monsterTypeList.size()) {
+        std::vector<int> indices, weights;
+        for (size_t i = 0; i < monsterTypeList.size(); i++) {
+            int weight = monsterWeight(monsterTypeList[i]);
+            if (monsterTypeList[i].eligible && weight > 0) {
+                indices.push_back(i);
+                weights.push_back(weight);
+            }
+        }
+        monsterTable.build(indices, weights);
+        monsterTable.types = monsterTypeList.size();
+    }
+    while (true) {
+        int index = monsterTable.pick();
+        if (index == -1 || monsterTypeList[index].eligible) {
+            return index;
+        }
+    }
+}
+
+int pickObjectType() {
+    if (objectTable.dirty || objectTable.types != objectTypeList.size()) {
+        std::vector<int> indices, weights;
+        for (size_t i = 0; i < objectTypeList.size(); i++) {
+            int weight = objectWeight(objectTypeList[i]);
+            if (objectTypeList[i].eligible && weight > 0) {
+                indices.push_back(i);
+                weights.push_back(weight);
+            }
+        }
+        objectTable.build(indices, weights);
+        objectTable.types = objectTypeList.size();
+    }
+    while (true) {
+        int index = objectTable.pick();
+        if (index == -1 || objectTypeList[index].eligible) {
+            return index;
+        }
+    }
+}
+
+// A type coming back may not be in the table at all, only leaving can be deferred
+static void changeEligibility(AliasTable& table, bool eligible, int weight) {
+    if (eligible) {
+        table.dirty = true;
+        return;
+    }
+    table.removed += weight;
+    if (table.removed * 2 >= table.total) {
+        table.dirty = true;
+    }
+}
+
+void setMonsterEligible(int index, bool eligible) {
+    if (monsterTypeList[index].eligible != eligible) {
+        monsterTypeList[index].eligible = eligible;
+        changeEligibility(monsterTable, eligible, monsterWeight(monsterTypeList[index]));
+    }
+}
+
+void setObjectEligible(int index, bool eligible) {
+    if (objectTypeList[index].eligible != eligible) {
+        objectTypeList[index].eligible = eligible;
+        changeEligibility(objectTable, eligible, objectWeight(objectTypeList[index]));
+    }
+}
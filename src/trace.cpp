@@ -0,0 +1,95 @@
+#include <cstdio>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+#include "trace.hpp"
+
+bool tracing = false;
+
+static FILE *traceFile = nullptr;
+static int64_t traceStart;
+static std::mutex buffersLock;
+static std::vector<std::unique_ptr<TraceBuffer>> buffers;
+static thread_local TraceBuffer *threadBuffer = nullptr;
+
+TraceBuffer::TraceBuffer(int tid) : tid(tid), threadName(nullptr), events(new TraceEvent[TRACE_RING_EVENTS]), pushed(0) {}
+
+void TraceBuffer::push(const char *name, const char *category, int64_t start, int64_t end) {
+    events[pushed & (TRACE_RING_EVENTS - 1)] = (TraceEvent){name, category, start, end};
+    pushed++;
+}
+
+// The lock is only taken the first time a thread records, after that every span stays thread local
+static TraceBuffer *currentBuffer() {
+    if (threadBuffer == nullptr) {
+        std::lock_guard<std::mutex> guard(buffersLock);
+        buffers.push_back(std::make_unique<TraceBuffer>(buffers.size()));
+        threadBuffer = buffers.back().get();
+    }
+    return threadBuffer;
+}
+
+bool startTracing(const char *filename) {
+    traceFile = fopen(filename, "w");
+    if (traceFile == nullptr) {
+        std::cout << "Error: Cannot open trace file " << filename << std::endl;
+        return false;
+    }
+
+    traceStart = monotonicNanos();
+    tracing = true;
+    nameTraceThread("game");
+    return true;
+}
+
+void nameTraceThread(const char *name) {
+    if (tracing) {
+        currentBuffer()->threadName = name;
+    }
+}
+
+void traceSpan(const char *name, const char *category, int64_t start, int64_t end) {
+    currentBuffer()->push(name, category, start, end);
+}
+
+// Every recording thread must have exited before this runs
+void stopTracing() {
+    if (!tracing) {
+        return;
+    }
+    tracing = false;
+
+    long lost = 0;
+    bool first = true;
+    fprintf(traceFile, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+    for (const auto& buffer : buffers) {
+        if (buffer->threadName != nullptr) {
+            fprintf(traceFile, "%s{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %d, \"args\": {\"name\": \"%s\"}}",
+                    first ? "" : ",\n", buffer->tid, buffer->threadName);
+            first = false;
+        }
+
+        size_t begin = 0;
+        if (buffer->pushed > TRACE_RING_EVENTS) {
+            begin = buffer->pushed - TRACE_RING_EVENTS;
+            lost += begin;
+        }
+        for (size_t i = begin; i < buffer->pushed; i++) {
+            const TraceEvent& event = buffer->events[i & (TRACE_RING_EVENTS - 1)];
+            fprintf(traceFile, "%s{\"name\": \"%s\", \"cat\": \"%s\", \"ph\": \"X\", \"ts\": %.3f, \"dur\": %.3f, \"pid\": 1, \"tid\": %d}",
+                    first ? "" : ",\n", event.name, event.category, (event.start - traceStart) / 1e3,
+                    (event.end - event.start) / 1e3, buffer->tid);
+            first = false;
+        }
+    }
+    fprintf(traceFile, "\n]}\n");
+    fclose(traceFile);
+    traceFile = nullptr;
+
+    buffers.clear();
+    threadBuffer = nullptr;
+    if (lost > 0) {
+        std::cout << "Trace buffers wrapped, the oldest " << lost << " spans were dropped" << std::endl;
+    }
+}